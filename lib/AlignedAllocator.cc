@@ -0,0 +1,405 @@
+#include <Grid.h>
+#include <sys/mman.h>
+#include <unordered_map>
+#include <new>
+#include <atomic>
+
+namespace Grid {
+
+uint64_t AllocationPool::MinBytes       = 4096;
+uint64_t AllocationPool::MaxCachedBytes = 128ULL*1024ULL*1024ULL;
+int      AllocationPool::PrintStatistics;
+int      AllocationPool::HugePages;
+uint64_t AllocationPool::HugePageBytes  = 2*1024*1024;
+thread_local int AllocationPool::CurrentCategory;
+
+////////////////////////////////////////////////////////////////////
+// Pool state is created on first use and never destroyed; vectors
+// owned by static objects may be allocated before, and freed after,
+// anything with static storage in this file.
+////////////////////////////////////////////////////////////////////
+struct AllocationPoolState {
+  std::map<size_t,std::vector<void *> > free_list;
+  AllocationPool::Statistics stats;
+
+  // Category registry; live blocks remember the category they were charged to
+  std::map<std::string,int>      category_index;
+  std::vector<std::string>       category_name;
+  std::vector<uint64_t>          category_live;
+  std::vector<uint64_t>          category_peak;
+  std::vector<uint64_t>          category_high_water;
+  std::unordered_map<void *,std::pair<int,uint64_t> > owner;
+
+  int Register(const std::string &name) {
+    std::map<std::string,int>::iterator it = category_index.find(name);
+    if ( it != category_index.end() ) return it->second;
+    int c = category_name.size();
+    category_index[name] = c;
+    category_name.push_back(name);
+    category_live.push_back(0);
+    category_peak.push_back(0);
+    category_high_water.push_back(0);
+    return c;
+  }
+
+  AllocationPoolState() {
+    Register("Other");
+    stats.hits              = 0;
+    stats.misses            = 0;
+    stats.bytes_in_use      = 0;
+    stats.peak_bytes_in_use = 0;
+    stats.bytes_cached      = 0;
+    stats.mapped            = 0;
+    stats.hugetlb           = 0;
+  }
+};
+
+static AllocationPoolState & PoolState(void)
+{
+  static AllocationPoolState *state = new AllocationPoolState;
+  return *state;
+}
+
+////////////////////////////////////////////////////////////////////
+// Huge page mappings; the block handed out is 2MB aligned inside the
+// mapping, which is recorded so the whole of it can be unmapped.
+////////////////////////////////////////////////////////////////////
+struct HugeMapping {
+  void  *base;
+  size_t length;
+};
+static std::map<void *,HugeMapping> & HugeMappings(void)
+{
+  static std::map<void *,HugeMapping> *mappings = new std::map<void *,HugeMapping>;
+  return *mappings;
+}
+static uint64_t HugeMapped;
+static uint64_t HugeTLB;
+static std::atomic<int> HugeLive(0); // mappings not yet unmapped
+
+////////////////////////////////////////////////////////////////////
+// Fresh system blocks are first touched with the site decomposition of
+// the lattice kernels: PARALLEL_FOR_LOOP over sites of site_bytes, each
+// page written once by the thread owning the site in which it begins.
+// Sites smaller than a page are grouped so that the loop runs over
+// roughly one page per iteration. Contents stay undefined.
+////////////////////////////////////////////////////////////////////
+static void FirstTouch(void *ptr,size_t bytes,size_t site_bytes)
+{
+  const uint64_t page = 4096;
+  uint64_t base  = (uint64_t)ptr;
+  uint64_t end   = base+bytes;
+  uint64_t grain = site_bytes*((page+site_bytes-1)/site_bytes);
+  int ngrain = (bytes+grain-1)/grain;
+PARALLEL_FOR_LOOP
+  for(int g=0;g<ngrain;g++){
+    uint64_t lo = base+g*grain;
+    uint64_t hi = std::min(lo+grain,end);
+    if ( g==0 ) *((volatile char *)lo) = 0;
+    for(uint64_t p=(lo+page-1)&~(page-1);p<hi;p+=page){
+      *((volatile char *)p) = 0;
+    }
+  }
+}
+
+static void *HugeAllocate(size_t bytes)
+{
+  size_t huge   = AllocationPool::HugePageBytes;
+  size_t length = ((bytes+huge-1)/huge)*huge;
+  int    tlb    = 0;
+  void  *base   = MAP_FAILED;
+  void  *ptr;
+
+#ifdef MAP_HUGETLB
+  base = mmap(NULL,length,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB,-1,0);
+  if ( base != MAP_FAILED ) tlb = 1;
+#endif
+  if ( base != MAP_FAILED ) {
+    ptr = base;
+  } else {
+    // No reserved pages; over map to get 2MB alignment for transparent huge pages
+    length = length+huge;
+    base = mmap(NULL,length,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+    if ( base == MAP_FAILED ) return NULL;
+    ptr = (void *)( (((uint64_t)base)+huge-1) & ~((uint64_t)huge-1) );
+#ifdef MADV_HUGEPAGE
+    madvise(ptr,length-huge,MADV_HUGEPAGE);
+#endif
+  }
+
+  HugeMapping m;
+  m.base   = base;
+  m.length = length;
+#pragma omp critical (GridHugeMappings)
+  {
+    HugeMappings()[ptr] = m;
+    HugeLive++;
+    HugeMapped++;
+    HugeTLB+=tlb;
+  }
+  return ptr;
+}
+
+static int HugeFree(void *ptr)
+{
+  HugeMapping m;
+  int found = 0;
+#pragma omp critical (GridHugeMappings)
+  {
+    std::map<void *,HugeMapping> &mappings = HugeMappings();
+    std::map<void *,HugeMapping>::iterator it = mappings.find(ptr);
+    if ( it != mappings.end() ) {
+      m = it->second;
+      mappings.erase(it);
+      HugeLive--;
+      found = 1;
+    }
+  }
+  if ( found ) munmap(m.base,m.length);
+  return found;
+}
+
+static void *SystemAllocate(size_t bytes)
+{
+  if ( AllocationPool::HugePages && (bytes >= AllocationPool::HugePageBytes) ) {
+    void *ptr = HugeAllocate(bytes);
+    if ( ptr != NULL ) return ptr;
+  }
+#ifdef HAVE_MM_MALLOC_H
+  return _mm_malloc(bytes,128);
+#else
+  return memalign(128,bytes);
+#endif
+}
+
+static void SystemFree(void *ptr)
+{
+  // Mode may have changed since the allocation; the mapping table decides,
+  // and is not consulted at all while it is empty
+  if ( HugeLive.load() && HugeFree(ptr) ) return;
+#ifdef HAVE_MM_MALLOC_H
+  _mm_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+// Idle blocks of other sizes may be what stands in the way; hand them
+// back and try once more before giving up. Under Linux overcommit the
+// allocation itself rarely fails and the OOM killer strikes on first
+// touch instead, so this only helps with overcommit off.
+static void *SystemAllocateOrRelease(size_t bytes)
+{
+  void *ptr = SystemAllocate(bytes);
+  if ( ptr == NULL ) {
+    AllocationPool::Release();
+    ptr = SystemAllocate(bytes);
+    if ( ptr == NULL ) throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+////////////////////////////////////////////////////////////////////
+// Blocks below MinBytes go straight to the system and are not
+// accounted; everything else is charged under the pool lock.
+////////////////////////////////////////////////////////////////////
+static void Charge(AllocationPoolState &pool,void *ptr,uint64_t bytes)
+{
+  int c = AllocationPool::CurrentCategory;
+  pool.owner[ptr] = std::make_pair(c,bytes);
+  pool.category_live[c] += bytes;
+  if ( pool.category_live[c] > pool.category_peak[c] ) {
+    pool.category_peak[c] = pool.category_live[c];
+  }
+  pool.stats.bytes_in_use += bytes;
+  if ( pool.stats.bytes_in_use > pool.stats.peak_bytes_in_use ) {
+    pool.stats.peak_bytes_in_use = pool.stats.bytes_in_use;
+    pool.category_high_water     = pool.category_live;
+  }
+}
+
+void *AllocationPool::Allocate(size_t bytes,size_t site_bytes)
+{
+  if ( bytes < MinBytes ) return SystemAllocateOrRelease(bytes);
+
+  void *ptr = NULL;
+#pragma omp critical (GridAllocationPool)
+  {
+    AllocationPoolState &pool = PoolState();
+    std::map<size_t,std::vector<void *> >::iterator it = pool.free_list.find(bytes);
+    if ( (it != pool.free_list.end()) && (it->second.size()>0) ) {
+      ptr = it->second.back();
+      it->second.pop_back();
+      pool.stats.bytes_cached -= bytes;
+      pool.stats.hits++;
+      Charge(pool,ptr,bytes);
+    } else {
+      pool.stats.misses++;
+    }
+  }
+  if ( ptr != NULL ) return ptr;
+
+  ptr = SystemAllocateOrRelease(bytes);
+  FirstTouch(ptr,bytes,site_bytes);
+#pragma omp critical (GridAllocationPool)
+  {
+    Charge(PoolState(),ptr,bytes);
+  }
+  return ptr;
+}
+
+void AllocationPool::Free(void *ptr,size_t bytes)
+{
+  if ( ptr == NULL ) return;
+  if ( bytes < MinBytes ) {
+    SystemFree(ptr);
+    return;
+  }
+  int cached = 0;
+#pragma omp critical (GridAllocationPool)
+  {
+    AllocationPoolState &pool = PoolState();
+    std::unordered_map<void *,std::pair<int,uint64_t> >::iterator it = pool.owner.find(ptr);
+    assert(it != pool.owner.end());
+    pool.category_live[it->second.first] -= bytes;
+    pool.owner.erase(it);
+    pool.stats.bytes_in_use -= bytes;
+    if ( pool.stats.bytes_cached+bytes <= MaxCachedBytes ) {
+      pool.free_list[bytes].push_back(ptr);
+      pool.stats.bytes_cached += bytes;
+      cached = 1;
+    }
+  }
+  if ( !cached ) SystemFree(ptr);
+}
+
+void AllocationPool::Release(void)
+{
+#pragma omp critical (GridAllocationPool)
+  {
+    AllocationPoolState &pool = PoolState();
+    std::map<size_t,std::vector<void *> >::iterator it;
+    for(it=pool.free_list.begin();it!=pool.free_list.end();it++){
+      for(int i=0;i<it->second.size();i++){
+	SystemFree(it->second[i]);
+      }
+    }
+    pool.free_list.clear();
+    pool.stats.bytes_cached = 0;
+  }
+}
+
+AllocationPool::Statistics AllocationPool::Stats(void)
+{
+  Statistics s;
+#pragma omp critical (GridAllocationPool)
+  {
+    s = PoolState().stats;
+  }
+#pragma omp critical (GridHugeMappings)
+  {
+    s.mapped  = HugeMapped;
+    s.hugetlb = HugeTLB;
+  }
+  return s;
+}
+
+int AllocationPool::CategoryIndex(const std::string &name)
+{
+  int c;
+#pragma omp critical (GridAllocationPool)
+  {
+    c = PoolState().Register(name);
+  }
+  return c;
+}
+
+std::string AllocationPool::CategoryName(int category)
+{
+  std::string name;
+#pragma omp critical (GridAllocationPool)
+  {
+    name = PoolState().category_name[category];
+  }
+  return name;
+}
+
+int AllocationPool::Categories(void)
+{
+  int n;
+#pragma omp critical (GridAllocationPool)
+  {
+    n = PoolState().category_name.size();
+  }
+  return n;
+}
+
+void AllocationPool::Attribute(const void *ptr,const std::string &name)
+{
+#pragma omp critical (GridAllocationPool)
+  {
+    AllocationPoolState &pool = PoolState();
+    std::unordered_map<void *,std::pair<int,uint64_t> >::iterator it = pool.owner.find((void *)ptr);
+    if ( it != pool.owner.end() ) { // blocks below MinBytes are not tracked
+      int from = it->second.first;
+      int to   = pool.Register(name);
+      uint64_t bytes = it->second.second;
+      pool.category_live[from] -= bytes;
+      pool.category_live[to]   += bytes;
+      if ( pool.category_live[to] > pool.category_peak[to] ) {
+	pool.category_peak[to] = pool.category_live[to];
+      }
+      it->second.first = to;
+    }
+  }
+}
+
+static uint64_t CategoryCount(const std::string &name,std::vector<uint64_t> AllocationPoolState::*count)
+{
+  uint64_t bytes=0;
+#pragma omp critical (GridAllocationPool)
+  {
+    AllocationPoolState &pool = PoolState();
+    std::map<std::string,int>::iterator it = pool.category_index.find(name);
+    if ( it != pool.category_index.end() ) bytes = (pool.*count)[it->second];
+  }
+  return bytes;
+}
+
+uint64_t AllocationPool::LiveBytes(const std::string &name)
+{
+  return CategoryCount(name,&AllocationPoolState::category_live);
+}
+uint64_t AllocationPool::PeakBytes(const std::string &name)
+{
+  return CategoryCount(name,&AllocationPoolState::category_peak);
+}
+uint64_t AllocationPool::HighWaterBytes(const std::string &name)
+{
+  return CategoryCount(name,&AllocationPoolState::category_high_water);
+}
+
+void AllocationPool::Report(Logger &log)
+{
+  Statistics s = Stats();
+  double MB = 1024.0*1024.0;
+  std::cout<<log<<"AllocationPool hits "<<s.hits<<" misses "<<s.misses<<std::endl;
+  std::cout<<log<<"AllocationPool in use "<<s.bytes_in_use/MB<<" MB; peak "
+	   <<s.peak_bytes_in_use/MB<<" MB; cached "<<s.bytes_cached/MB<<" MB"<<std::endl;
+  if ( HugePages ) {
+    std::cout<<log<<"AllocationPool huge page blocks "<<s.mapped<<" of which "<<s.hugetlb<<" MAP_HUGETLB"<<std::endl;
+  }
+  std::cout<<log<<"AllocationPool "<<std::setw(16)<<std::left<<"category"
+	   <<std::setw(12)<<std::right<<"live MB"
+	   <<std::setw(12)<<std::right<<"peak MB"
+	   <<std::setw(16)<<std::right<<"at high water"<<std::endl;
+  for(int c=0;c<Categories();c++){
+    std::string name = CategoryName(c);
+    std::cout<<log<<"AllocationPool "<<std::setw(16)<<std::left<<name
+	     <<std::setw(12)<<std::right<<LiveBytes(name)/MB
+	     <<std::setw(12)<<std::right<<PeakBytes(name)/MB
+	     <<std::setw(16)<<std::right<<HighWaterBytes(name)/MB<<std::endl;
+  }
+}
+
+}
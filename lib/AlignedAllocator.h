@@ -8,6 +8,7 @@
 #include <malloc.h>
 #endif
 
+#include <stdint.h>
 #include <immintrin.h>
 #ifdef HAVE_MM_MALLOC_H
 #include <mm_malloc.h>
@@ -15,6 +16,97 @@
 
 namespace Grid {
 
+////////////////////////////////////////////////////////////////////
+// Free list pool behind alignedAllocator.
+//
+// Lattice payloads come in a handful of exact sizes and temporaries are
+// created and destroyed constantly; a freed block is kept on a per size
+// free list and handed to the next request of the same size, so the
+// system allocator (mmap/munmap and fresh page faults for large blocks)
+// is only hit when the pool has nothing of that size.
+//
+// Blocks below MinBytes bypass the pool altogether: they are neither
+// cached nor counted in the statistics below. At most MaxCachedBytes
+// are held idle per rank, 128MB unless raised with --alloc-pool-cache
+// MB; 0 turns the pool off. Every rank on a node holds its own cache.
+// Release() hands every idle block back to the system; it is also tried
+// once when the system allocator fails, before throwing std::bad_alloc.
+// That retry only helps when the kernel refuses the mapping: with Linux
+// overcommit (the default) mmap succeeds and the OOM killer fires when
+// the pages are first touched, so leave headroom for the cache instead.
+//
+// With HugePages (--hugepages) blocks of HugePageBytes and above are
+// mmapped on 2MB pages, MAP_HUGETLB if the system has reserved pages
+// and transparent huge pages via madvise otherwise.
+//
+// Blocks fresh from the system (not free list hits) are first touched
+// by all threads with the static schedule of PARALLEL_FOR_LOOP over
+// sites of site_bytes, the element size alignedAllocator passes, so
+// each thread's sites are placed on its own NUMA node.
+//
+// Live bytes are also charged to a category: the innermost
+// AllocationCategory scope on the allocating thread, "Other" outside
+// any. Scopes on hot paths should cache the index from CategoryIndex
+// and open only where they allocate;
+// Attribute() moves a live block, e.g. a member built in an
+// initialiser list, to another category.
+// Per category live and peak bytes, and the breakdown at the global
+// high-water mark, are queryable and printed by Report(); --log Memory
+// or --alloc-stats prints them at Grid_finalize.
+////////////////////////////////////////////////////////////////////
+class AllocationPool {
+public:
+
+  struct Statistics {
+    uint64_t hits;        // served from a free list
+    uint64_t misses;      // went to the system allocator
+    uint64_t bytes_in_use;
+    uint64_t peak_bytes_in_use;
+    uint64_t bytes_cached;
+    uint64_t mapped;      // huge page blocks from mmap
+    uint64_t hugetlb;     // of which on reserved MAP_HUGETLB pages
+  };
+
+  static uint64_t MinBytes;
+  static uint64_t MaxCachedBytes;
+  static int      HugePages;
+  static uint64_t HugePageBytes;
+  static int      PrintStatistics; // report at Grid_finalize (--alloc-stats)
+
+  static void *Allocate(size_t bytes,size_t site_bytes=1);
+  static void  Free    (void *ptr,size_t bytes);
+  static void  Release (void);
+
+  static Statistics Stats(void);
+  static void       Report(Logger &log=GridLogMessage);
+
+  static int         CategoryIndex(const std::string &name); // registers on first use
+  static std::string CategoryName (int category);
+  static int         Categories   (void);
+  static uint64_t    LiveBytes    (const std::string &name);
+  static uint64_t    PeakBytes    (const std::string &name);
+  static uint64_t    HighWaterBytes(const std::string &name); // live at the global peak
+  static void        Attribute(const void *ptr,const std::string &name); // recharge a live block
+
+  static thread_local int CurrentCategory;
+};
+
+class AllocationCategory {
+  int saved;
+public:
+  AllocationCategory(const std::string &name) {
+    saved = AllocationPool::CurrentCategory;
+    AllocationPool::CurrentCategory = AllocationPool::CategoryIndex(name);
+  }
+  AllocationCategory(int category) {
+    saved = AllocationPool::CurrentCategory;
+    AllocationPool::CurrentCategory = category;
+  }
+  ~AllocationCategory() {
+    AllocationPool::CurrentCategory = saved;
+  }
+};
+
 ////////////////////////////////////////////////////////////////////
 // A lattice of something, but assume the something is SIMDized.
 ////////////////////////////////////////////////////////////////////
@@ -46,20 +138,12 @@ public:
 
   pointer allocate(size_type __n, const void* = 0)
   { 
-#ifdef HAVE_MM_MALLOC_H
-    _Tp * ptr = (_Tp *) _mm_malloc(__n*sizeof(_Tp),128);
-#else
-    _Tp * ptr = (_Tp *) memalign(128,__n*sizeof(_Tp));
-#endif
+    _Tp * ptr = (_Tp *) AllocationPool::Allocate(__n*sizeof(_Tp),sizeof(_Tp));
     return ptr;
   }
 
-  void deallocate(pointer __p, size_type) { 
-#ifdef HAVE_MM_MALLOC_H
-    _mm_free((void *)__p); 
-#else
-    free((void *)__p);
-#endif
+  void deallocate(pointer __p, size_type __n) { 
+    AllocationPool::Free((void *)__p,__n*sizeof(_Tp));
   }
   void construct(pointer __p, const _Tp& __val) { };
   void construct(pointer __p) { };
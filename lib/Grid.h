@@ -15,6 +15,7 @@
 #include <cassert>
 #include <complex>
 #include <vector>
+#include <map>
 #include <iostream>
 #include <iomanip>
 #include <random>
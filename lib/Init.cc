@@ -33,6 +33,7 @@ static std::vector<int> Grid_default_mpi;
 int GridThread::_threads =1;
 int GridThread::_hyperthreads=1;
 int GridThread::_cores=1;
+int GridThread::_comms_threads=0;
 
 const std::vector<int> &GridDefaultLatt(void)     {return Grid_default_latt;};
 const std::vector<int> &GridDefaultMpi(void)      {return Grid_default_mpi;};
@@ -131,6 +132,12 @@ void GridParseLayout(char **argv,int argc,
     GridCmdOptionIntVector(arg,cores);
     GridThread::SetCores(cores[0]);
   }
+  if( GridCmdOptionExists(argv,argv+argc,"--comms-threads") ){
+    std::vector<int> comms(0);
+    arg= GridCmdOptionPayload(argv,argv+argc,"--comms-threads");
+    GridCmdOptionIntVector(arg,comms);
+    GridThread::SetCommsThreads(comms[0]);
+  }
 
 }
 
@@ -145,7 +152,8 @@ std::string GridCmdVectorIntToString(const std::vector<int> & vec){
 void Grid_init(int *argc,char ***argv)
 {
 #ifdef GRID_COMMS_MPI
-  MPI_Init(argc,argv);
+  int provided;
+  MPI_Init_thread(argc,argv,MPI_THREAD_FUNNELED,&provided);
 #endif
   // Parse command line args.
 
@@ -165,8 +173,18 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"--decomposition : report on default omp,mpi and simd decomposition"<<std::endl;    
     std::cout<<GridLogMessage<<"--mpi n.n.n.n   : default MPI decomposition"<<std::endl;    
     std::cout<<GridLogMessage<<"--omp n         : default number of OMP threads"<<std::endl;    
+    std::cout<<GridLogMessage<<"--comms-threads n : threads reserved for halo exchange in Dslash"<<std::endl;    
     std::cout<<GridLogMessage<<"--grid n.n.n.n  : default Grid size"<<std::endl;    
-    std::cout<<GridLogMessage<<"--log list      : comma separted list of streams from Error,Warning,Message,Performance,Iterative,Debug"<<std::endl;    
+    std::cout<<GridLogMessage<<"--topology      : keep the largest faces between ranks on the same node"<<std::endl;    
+    std::cout<<GridLogMessage<<"--dslash-tune   : time Dslash kernels and site orders per volume, keep the fastest"<<std::endl;    
+    std::cout<<GridLogMessage<<"--dslash-tune-file f : cache of tuned choices, read and appended (default dslash.tune)"<<std::endl;    
+    std::cout<<GridLogMessage<<"--alloc-pool-cache MB : idle lattice memory kept for reuse per rank (default 128, 0 disables)"<<std::endl;    
+    std::cout<<GridLogMessage<<"--hugepages     : back large lattice fields with 2MB pages, first touched by the owning threads"<<std::endl;    
+    std::cout<<GridLogMessage<<"--alloc-stats   : report allocation pool hits, misses and peak footprint at exit"<<std::endl;    
+    std::cout<<GridLogMessage<<"--log list      : comma separted list of streams from Error,Warning,Message,Performance,Iterative,Debug,Memory"<<std::endl;    
+#ifdef GRID_COMMS_SHMEM
+    std::cout<<GridLogMessage<<"--shm MB        : shared memory halo staging per rank"<<std::endl;    
+#endif
   }
 
   if( GridCmdOptionExists(*argv,*argv+*argc,"--log") ){
@@ -186,6 +204,36 @@ void Grid_init(int *argc,char ***argv)
     QCD::WilsonFermionStatic::HandOptDslash=1;
     QCD::WilsonFermion5DStatic::HandOptDslash=1;
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-tune") ){
+    QCD::DslashTuner::Enabled=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--dslash-tune-file") ){
+    QCD::DslashTuner::CacheFile = GridCmdOptionPayload(*argv,*argv+*argc,"--dslash-tune-file");
+  }
+#ifdef GRID_COMMS_SHMEM
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--shm") ){
+    std::vector<int> MB(0);
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--shm");
+    GridCmdOptionIntVector(arg,MB);
+    CartesianCommunicator::ShmBytes = (uint64_t)MB[0]*1024*1024;
+  }
+#endif
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--alloc-pool-cache") ){
+    std::vector<int> MB(0);
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--alloc-pool-cache");
+    GridCmdOptionIntVector(arg,MB);
+    AllocationPool::MaxCachedBytes = (uint64_t)MB[0]*1024*1024;
+    if ( MB[0]==0 ) AllocationPool::Release();
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--hugepages") ){
+    AllocationPool::HugePages=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--alloc-stats") ){
+    AllocationPool::PrintStatistics=1;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--topology") ){
+    CartesianCommunicator::TopologyAware=1;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--lebesgue") ){
     LebesgueOrder::UseLebesgueOrder=1;
   }
@@ -197,6 +245,13 @@ void Grid_init(int *argc,char ***argv)
   GridParseLayout(*argv,*argc,
 		  Grid_default_latt,
 		  Grid_default_mpi);
+#ifdef GRID_COMMS_MPI
+  // Comms threads call MPI from the master thread inside a parallel region
+  if ( (provided < MPI_THREAD_FUNNELED) && GridThread::GetCommsThreads() ) {
+    std::cout<<GridLogWarning<<"MPI_Init_thread did not provide MPI_THREAD_FUNNELED; --comms-threads ignored"<<std::endl;
+    GridThread::SetCommsThreads(0);
+  }
+#endif
   if( GridCmdOptionExists(*argv,*argv+*argc,"--decomposition") ){
     std::cout<<GridLogMessage<<"Grid Decomposition\n";
     std::cout<<GridLogMessage<<"\tOpenMP threads : "<<GridThread::GetThreads()<<std::endl;
@@ -213,6 +268,11 @@ void Grid_init(int *argc,char ***argv)
   
 void Grid_finalize(void)
 {
+  if ( AllocationPool::PrintStatistics ) AllocationPool::Report();
+  else if ( GridLogMemory.isActive() )   AllocationPool::Report(GridLogMemory);
+#ifdef GRID_COMMS_SHMEM
+  CartesianCommunicator::ShmFinalize();
+#endif
 #ifdef GRID_COMMS_MPI
   MPI_Finalize();
   Grid_unquiesce_nodes();
@@ -11,6 +11,7 @@ GridLogger GridLogMessage    (1,"Message");
 GridLogger GridLogDebug      (1,"Debug");
 GridLogger GridLogPerformance(1,"Performance");
 GridLogger GridLogIterative  (1,"Iterative");
+GridLogger GridLogMemory     (1,"Memory");
 
 void GridLogConfigure(std::vector<std::string> &logstreams)
 {
@@ -20,6 +21,7 @@ void GridLogConfigure(std::vector<std::string> &logstreams)
   GridLogIterative.Active(0);
   GridLogDebug.Active(0);
   GridLogPerformance.Active(0);
+  GridLogMemory.Active(0);
 
   for(int i=0;i<logstreams.size();i++){
     if ( logstreams[i]== std::string("Error")       ) GridLogError.Active(1);
@@ -28,6 +30,7 @@ void GridLogConfigure(std::vector<std::string> &logstreams)
     if ( logstreams[i]== std::string("Iterative")   ) GridLogIterative.Active(1);
     if ( logstreams[i]== std::string("Debug")       ) GridLogDebug.Active(1);
     if ( logstreams[i]== std::string("Performance") ) GridLogPerformance.Active(1);
+    if ( logstreams[i]== std::string("Memory")      ) GridLogMemory.Active(1);
   }
 }
 
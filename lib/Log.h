@@ -49,6 +49,7 @@ extern GridLogger GridLogMessage;
 extern GridLogger GridLogDebug  ;
 extern GridLogger GridLogPerformance;
 extern GridLogger GridLogIterative  ;
+extern GridLogger GridLogMemory     ;
 
 }
 #endif
@@ -133,6 +133,7 @@ namespace Grid {
 
 #include <simd/Grid_vector_types.h>
 #include <simd/Grid_vector_unops.h>
+#include <simd/Grid_half.h>
 
 namespace Grid {
   // Default precision
@@ -41,11 +41,12 @@
 
 namespace Grid {
   
+  // One 32 bit word per neighbour; a site's npoints entries are contiguous
   struct StencilEntry { 
-    int _offset;
-    int _is_local;
-    int _permute;
-    int _around_the_world;
+    uint32_t _offset:29;
+    uint32_t _is_local:1;
+    uint32_t _permute:1;
+    uint32_t _around_the_world:1;
   };
 
   template<class vobj,class cobj, class compressor>
@@ -53,6 +54,7 @@ namespace Grid {
   public:
 
       typedef uint32_t StencilInteger;
+      typedef CartesianCommunicator::CommsRequest_t CommsRequest_t;
       typedef typename cobj::vector_type vector_type;
       typedef typename cobj::scalar_type scalar_type;
       typedef typename cobj::scalar_object scalar_object;
@@ -67,17 +69,108 @@ namespace Grid {
       std::vector<int>                  _comm_buf_size;
       std::vector<int>                  _permute_type;
 
-      // npoints x Osites() of these
-      std::vector<std::vector<StencilEntry> > _entries;
+      // Osites() x npoints of these, site major
+      std::vector<StencilEntry> _entries;
+      inline StencilEntry & Entry(int point,int osite) { return _entries[osite*_npoints+point]; }
+
+      // Comms buffers, allocated once at construction.
+      // One send slot per unified buffer word; every message posted by HaloExchangeBegin
+      // keeps its own storage until HaloExchangeComplete. SIMD split faces extract
+      // lanes into per lane slices at the same unified buffer offset.
+      Vector<cobj> u_send_buf;
+      std::vector<Vector<scalar_object> > u_simd_send_buf;
+      std::vector<Vector<scalar_object> > u_simd_recv_buf;
+
+      // Buffers, ranks and sizes repeat exactly from one exchange to the next, so the
+      // first exchange in each wire format records persistent requests and later ones
+      // only restart them. Rebuilt if the caller's comms buffer moves.
+      struct CommsPlan {
+	void *recv_base;
+	int   built;
+	std::vector<CommsRequest_t> requests;
+      };
+      CommsPlan _plans[2]; // full, half precision
+      int _plan;
+      int _posted;
+
+      // Faces and messages of the exchange in progress, tabulated by HaloExchangePrepare.
+      // A face is one plane gathered into the unified buffer, or into per lane slices
+      // if SIMD split; pack is the mask of lanes (bit 0 if whole) narrowed to binary16.
+      struct Face {
+	int point;
+	int dimension;
+	int plane;
+	int cbmask;
+	int offset;
+	int words;
+	int splice;
+	int pack;
+      };
+      std::vector<Face> _faces;
+      struct Message {
+	void *xmit;
+	int   xmit_to_rank;
+	void *recv;
+	int   recv_from_rank;
+	int   bytes;
+      };
+      std::vector<Message> _messages;
+
+      // Lane merges into the unified buffer deferred to HaloExchangeComplete; lanes
+      // received in binary16 are widened from hpointers first
+      struct Merge {
+	cobj * mpointer;
+	std::vector<scalar_object *> rpointers;
+	std::vector<RealH *> hpointers;
+	int buffer_size;
+      };
+      std::vector<Merge> _mergers;
+
+      // Binary16 wire buffers when the compressor asks for HalfPrecisionComms; sized on
+      // first use. Received faces are widened into the buffers above before any merge.
+      Vector<RealH> h_send_buf;
+      Vector<RealH> h_recv_buf;
+      std::vector<Vector<RealH> > h_simd_send_buf;
+      std::vector<Vector<RealH> > h_simd_recv_buf;
+      struct Unpack {   // a face received whole into the unified buffer
+	RealH *hpointer;
+	int buffer_size;
+	cobj *cpointer;
+      };
+      std::vector<Unpack> _unpackers;
+
+      inline StencilEntry * GetEntry(int &ptype,int point,int osite) { ptype = _permute_type[point]; return & _entries[osite*_npoints+point]; }
+
+      // True if no point of the stencil at this site reads from the comms buffer
+      inline int SiteIsLocal(int osite) {
+	for(int point=0;point<_npoints;point++){
+	  if ( !Entry(point,osite)._is_local ) return 0;
+	}
+	return 1;
+      }
 
-      // Comms buffers
-      std::vector<std::vector<scalar_object> > send_buf_extract;
-      std::vector<std::vector<scalar_object> > recv_buf_extract;
-      std::vector<scalar_object *> pointers;
-      std::vector<scalar_object *> rpointers;
-      Vector<cobj> send_buf;
+      // Sites that can be computed before, and must wait for, HaloExchangeComplete.
+      // Entries index outer sites in units of Ls; Even/Odd stencils hold their own.
+      std::vector<int> _interior_sites;
+      std::vector<int> _surface_sites;
 
-      inline StencilEntry * GetEntry(int &ptype,int point,int osite) { ptype = _permute_type[point]; return & _entries[point][osite]; }
+      // Ls>1 when an unrolled, node local, innermost dimension is folded into the site
+      // index by the caller; optionally emit the tables in cache blocked order.
+      void BuildSiteTables(int Ls,LebesgueOrder *lo=NULL)
+      {
+	int osites = _grid->oSites();
+	assert(osites%Ls==0);
+	int vol    = osites/Ls;
+
+	_interior_sites.resize(0);
+	_surface_sites.resize(0);
+	for(int ss=0;ss<vol;ss++){
+	  int site = ss;
+	  if ( lo ) site = lo->Reorder(ss);
+	  if ( SiteIsLocal(site*Ls) ) _interior_sites.push_back(site);
+	  else                        _surface_sites.push_back(site);
+	}
+      }
 
       int _unified_buffer_size;
       int _request_count;
@@ -101,8 +194,10 @@ namespace Grid {
 				     int checkerboard,
 				     const std::vector<int> &directions,
 				     const std::vector<int> &distances) 
-    :   _entries(npoints), _permute_type(npoints), _comm_buf_size(npoints)
+    :   _permute_type(npoints), _comm_buf_size(npoints)
     {
+      AllocationCategory category("Stencil");
+
       gathertime=0;
       commtime=0;
       commstime=0;
@@ -120,15 +215,20 @@ namespace Grid {
       _distances  = distances;
       _unified_buffer_size=0;
       _request_count =0;
+      _plan   = 0;
+      _posted = 0;
+      for(int p=0;p<2;p++){
+	_plans[p].recv_base = NULL;
+	_plans[p].built     = 0;
+      }
 
       int osites  = _grid->oSites();
+      _entries.resize(npoints*osites);
 
       for(int i=0;i<npoints;i++){
 
 	int point = i;
 
-	_entries[i].resize( osites);
-
 	int dimension    = directions[i];
 	int displacement = distances[i];
 	int shift = displacement;
@@ -173,13 +273,37 @@ namespace Grid {
 	  }
 	}
 	//	for(int ss=0;ss<osites;ss++){
-	  //	  std::cout << "point["<<i<<"] "<<ss<<"-> o"<<_entries[i][ss]._offset<<"; l"<<
-	  //	    _entries[i][ss]._is_local<<"; p"<<_entries[i][ss]._permute<<std::endl;
+	  //	  std::cout << "point["<<i<<"] "<<ss<<"-> o"<<Entry(i,ss)._offset<<"; l"<<
+	  //	    Entry(i,ss)._is_local<<"; p"<<Entry(i,ss)._permute<<std::endl;
 	//	}
       }
+      assert(osites<(1<<29) && _unified_buffer_size<(1<<29)); // StencilEntry::_offset width
+      BuildSiteTables(1);
+
+      u_send_buf.resize(_unified_buffer_size);
+      int splice = 0;
+      for(int point=0;point<npoints;point++){
+	int dimension = directions[point];
+	if ( (_grid->_simd_layout[dimension]>1) && (_grid->_processors[dimension]>1) ) splice=1;
+      }
+      if ( splice ) {
+	u_simd_send_buf.resize(_grid->Nsimd());
+	u_simd_recv_buf.resize(_grid->Nsimd());
+	for(int l=0;l<_grid->Nsimd();l++){
+	  u_simd_send_buf[l].resize(_unified_buffer_size);
+	  u_simd_recv_buf[l].resize(_unified_buffer_size);
+	}
+      }
     }
 
 
+    ~CartesianStencil()
+    {
+      for(int p=0;p<2;p++){
+	_grid->SendToRecvFromFree(_plans[p].requests);
+      }
+    }
+
     void Local     (int point, int dimension,int shiftpm,int cbmask)
     {
       int fd = _grid->_fdimensions[dimension];
@@ -301,10 +425,10 @@ namespace Grid {
 	// Simple block stride gather of SIMD objects
 	for(int n=0;n<_grid->_slice_nblock[dimension];n++){
 	  for(int b=0;b<_grid->_slice_block[dimension];b++){
-	    _entries[point][lo+o+b]._offset  =ro+o+b;
-	    _entries[point][lo+o+b]._is_local=1;
-	    _entries[point][lo+o+b]._permute=permute;
-	    _entries[point][lo+o+b]._around_the_world=wrap;
+	    Entry(point,lo+o+b)._offset  =ro+o+b;
+	    Entry(point,lo+o+b)._is_local=1;
+	    Entry(point,lo+o+b)._permute=permute;
+	    Entry(point,lo+o+b)._around_the_world=wrap;
 	  }
 	  o +=_grid->_slice_stride[dimension];
 	}
@@ -321,10 +445,10 @@ namespace Grid {
 	    int ocb=1<<_grid->CheckerBoardFromOindex(o+b);
 	    
 	    if ( ocb&cbmask ) {
-	      _entries[point][lo+o+b]._offset =ro+o+b;
-	      _entries[point][lo+o+b]._is_local=1;
-	      _entries[point][lo+o+b]._permute=permute;
-	      _entries[point][lo+o+b]._around_the_world=wrap;
+	      Entry(point,lo+o+b)._offset =ro+o+b;
+	      Entry(point,lo+o+b)._is_local=1;
+	      Entry(point,lo+o+b)._permute=permute;
+	      Entry(point,lo+o+b)._around_the_world=wrap;
 	    }
 	    
 	    }
@@ -347,10 +471,10 @@ namespace Grid {
 	// Simple block stride gather of SIMD objects
 	for(int n=0;n<_grid->_slice_nblock[dimension];n++){
 	  for(int b=0;b<_grid->_slice_block[dimension];b++){
-	    _entries[point][so+o+b]._offset  =offset+(bo++);
-	    _entries[point][so+o+b]._is_local=0;
-	    _entries[point][so+o+b]._permute=0;
-	    _entries[point][so+o+b]._around_the_world=wrap;
+	    Entry(point,so+o+b)._offset  =offset+(bo++);
+	    Entry(point,so+o+b)._is_local=0;
+	    Entry(point,so+o+b)._permute=0;
+	    Entry(point,so+o+b)._around_the_world=wrap;
 	  }
 	  o +=_grid->_slice_stride[dimension];
 	}
@@ -366,10 +490,10 @@ namespace Grid {
 
 	    int ocb=1<<_grid->CheckerBoardFromOindex(o+b);// Could easily be a table lookup
 	    if ( ocb & cbmask ) {
-	      _entries[point][so+o+b]._offset  =offset+(bo++);
-	      _entries[point][so+o+b]._is_local=0;
-	      _entries[point][so+o+b]._permute =0;
-	      _entries[point][so+o+b]._around_the_world=wrap;
+	      Entry(point,so+o+b)._offset  =offset+(bo++);
+	      Entry(point,so+o+b)._is_local=0;
+	      Entry(point,so+o+b)._permute =0;
+	      Entry(point,so+o+b)._around_the_world=wrap;
 	    }
 	  }
 	  o +=_grid->_slice_stride[dimension];
@@ -392,20 +516,102 @@ namespace Grid {
    //      void ScatterPlane (int point,int dimension,int plane,int cbmask,int offset,int wrap);
 
       // Could allow a functional munging of the halo to another type during the comms.
-      // this could implement the 16bit/32bit/64bit compression.
+      // 16bit is implemented: compressor.HalfPrecisionComms() selects binary16 faces.
       void HaloExchange(const Lattice<vobj> &source,std::vector<cobj,alignedAllocator<cobj> > &u_comm_buf,compressor &compress)
+      {
+	HaloExchangeBegin(source,u_comm_buf,compress);
+	HaloExchangeComplete();
+      }
+
+      //////////////////////////////////////////////////////////////////////////////////
+      // Split phase halo exchange. Begin gathers every face and posts the transfers;
+      // sites for which SiteIsLocal() holds may be computed before Complete returns.
+      // Complete waits and merges the lanes of SIMD split faces into the buffer.
+      //
+      // The phases are public so that a subset of an enclosing thread team can drive
+      // the exchange while the rest computes (GridThread::SetCommsThreads):
+      //   HaloExchangePrepare  one thread, outside the team; sizes buffers, tabulates
+      //   HaloGather           share me of n threads; gather, compress, narrow
+      //   HaloExchangeStart    thread 0, after every share is gathered; posts MPI
+      //   HaloExchangeWait     thread 0; completes MPI
+      //   HaloMerge            share me of n threads, after the wait; widen, merge
+      //   HaloExchangeFinish   one thread, after every share is merged
+      //////////////////////////////////////////////////////////////////////////////////
+      void HaloExchangeBegin(const Lattice<vobj> &source,std::vector<cobj,alignedAllocator<cobj> > &u_comm_buf,compressor &compress)
+      {
+	halotime-=usecond();
+	HaloExchangePrepare(source,u_comm_buf,compress);
+	gathertime-=usecond();
+	int nthreads = GridThread::GetThreads();
+PARALLEL_FOR_LOOP
+	for(int t=0;t<nthreads;t++){
+	  HaloGather(source,compress,t,nthreads);
+	}
+	gathertime+=usecond();
+	HaloExchangeStart();
+	halotime+=usecond();
+      }
+
+      void HaloExchangeComplete(void)
+      {
+	halotime-=usecond();
+	HaloExchangeWait();
+	mergetime-=usecond();
+	int nthreads = GridThread::GetThreads();
+PARALLEL_FOR_LOOP
+	for(int t=0;t<nthreads;t++){
+	  HaloMerge(t,nthreads);
+	}
+	mergetime+=usecond();
+	HaloExchangeFinish();
+	halotime+=usecond();
+      }
+
+      void HaloExchangePrepare(const Lattice<vobj> &source,std::vector<cobj,alignedAllocator<cobj> > &u_comm_buf,compressor &compress)
       {
 	// conformable(source._grid,_grid);
 	assert(source._grid==_grid);
-	halotime-=usecond();
-	if (u_comm_buf.size() != _unified_buffer_size ) u_comm_buf.resize(_unified_buffer_size);
+	assert(_posted==0); // previous exchange must be completed
+	assert(_mergers.size()==0);
+	assert(_unpackers.size()==0);
+	buftime-=usecond();
+	static int category = AllocationPool::CategoryIndex("Stencil");
+	if (u_comm_buf.size() != _unified_buffer_size ) {
+	  AllocationCategory scope(category);
+	  u_comm_buf.resize(_unified_buffer_size);
+	}
+
+	_plan = compress.HalfPrecisionComms() ? 1 : 0;
+	CommsPlan &plan = _plans[_plan];
+	void *recv_base = u_comm_buf.size() ? (void *)&u_comm_buf[0] : NULL;
+	if ( plan.built && (plan.recv_base != recv_base) ) {
+	  _grid->SendToRecvFromFree(plan.requests);
+	  plan.built = 0;
+	}
+	plan.recv_base = recv_base;
+	if ( compress.HalfPrecisionComms() ) {
+	  if ( h_send_buf.size() != _unified_buffer_size*HalfWords<cobj>() ) {
+	    AllocationCategory scope(category);
+	    h_send_buf.resize(_unified_buffer_size*HalfWords<cobj>());
+	    h_recv_buf.resize(_unified_buffer_size*HalfWords<cobj>());
+	  }
+	  if ( h_simd_send_buf.size() != u_simd_send_buf.size() ) {
+	    AllocationCategory scope(category);
+	    h_simd_send_buf.resize(u_simd_send_buf.size());
+	    h_simd_recv_buf.resize(u_simd_recv_buf.size());
+	    for(int l=0;l<h_simd_send_buf.size();l++){
+	      h_simd_send_buf[l].resize(_unified_buffer_size*HalfWords<scalar_object>());
+	      h_simd_recv_buf[l].resize(_unified_buffer_size*HalfWords<scalar_object>());
+	    }
+	  }
+	}
+	_faces.resize(0);
+	_messages.resize(0);
 	int u_comm_offset=0;
 
-	// Gather all comms buffers
+	// Tabulate all comms buffers
 	for(int point = 0 ; point < _npoints; point++) {
 
-	  compress.Point(point);
-
 	  int dimension    = _directions[point];
 	  int displacement = _distances[point];
 	  
@@ -431,40 +637,172 @@ namespace Grid {
 	    sshift[1] = _grid->CheckerBoardShiftForCB(_checkerboard,dimension,shift,Odd);
 	    if ( sshift[0] == sshift[1] ) {
 	      if (splice_dim) {
-		splicetime-=usecond();
-		GatherStartCommsSimd(source,dimension,shift,0x3,u_comm_buf,u_comm_offset,compress);
-		splicetime+=usecond();
+		TabulateCommsSimd(source,point,dimension,shift,0x3,u_comm_buf,u_comm_offset,compress);
 	      } else { 
-		nosplicetime-=usecond();
-		GatherStartComms(source,dimension,shift,0x3,u_comm_buf,u_comm_offset,compress);
-		nosplicetime+=usecond();
+		TabulateComms(source,point,dimension,shift,0x3,u_comm_buf,u_comm_offset,compress);
 	      }
 	    } else {
 	      std::cout << "dim "<<dimension<<"cb "<<_checkerboard<<"shift "<<shift<<" sshift " << sshift[0]<<" "<<sshift[1]<<std::endl;
 	      if(splice_dim){
-		splicetime-=usecond();
-		GatherStartCommsSimd(source,dimension,shift,0x1,u_comm_buf,u_comm_offset,compress);// if checkerboard is unfavourable take two passes
-		GatherStartCommsSimd(source,dimension,shift,0x2,u_comm_buf,u_comm_offset,compress);// both with block stride loop iteration
-		splicetime+=usecond();
+		TabulateCommsSimd(source,point,dimension,shift,0x1,u_comm_buf,u_comm_offset,compress);// if checkerboard is unfavourable take two passes
+		TabulateCommsSimd(source,point,dimension,shift,0x2,u_comm_buf,u_comm_offset,compress);// both with block stride loop iteration
 	      } else {
-		nosplicetime-=usecond();
-		GatherStartComms(source,dimension,shift,0x1,u_comm_buf,u_comm_offset,compress);
-		GatherStartComms(source,dimension,shift,0x2,u_comm_buf,u_comm_offset,compress);
-		nosplicetime+=usecond();
+		TabulateComms(source,point,dimension,shift,0x1,u_comm_buf,u_comm_offset,compress);
+		TabulateComms(source,point,dimension,shift,0x2,u_comm_buf,u_comm_offset,compress);
+	      }
+	    }
+	  }
+	}
+	buftime+=usecond();
+      }
+
+      //////////////////////////////////////////////////////////////////////////////////
+      // Share me of nthreads of every face: a contiguous run of the face's sites. The
+      // compressor is copied because Point() selects the projection per face.
+      //////////////////////////////////////////////////////////////////////////////////
+      void HaloGather(const Lattice<vobj> &rhs,compressor &compress,int me,int nthreads)
+      {
+	compressor compress_me(compress);
+	const int Nsimd = _grid->Nsimd();
+	const int hw    = HalfWords<cobj>();
+	const int hws   = HalfWords<scalar_object>();
+	std::vector<scalar_object *> pointers(Nsimd);
+
+	for(int f=0;f<_faces.size();f++){
+	  Face &face = _faces[f];
+	  compress_me.Point(face.point);
+
+	  int dimension = face.dimension;
+	  int plane     = face.plane;
+	  int so        = plane*_grid->_ostride[dimension]; // base offset for start of plane 
+	  int e2        = _grid->_slice_block[dimension];
+	  int stride    = _grid->_slice_stride[dimension];
+
+	  if ( face.cbmask != 0x3 ) {
+	    // Checkerboard selected sites are packed with a running count; one share
+	    if ( me==0 ) {
+	      Gather_plane_simple (rhs,u_send_buf,dimension,plane,face.cbmask,compress_me,face.offset);
+	      if ( face.pack ) {
+		for(int i=0;i<face.words;i++){
+		  PackHalf(&h_send_buf[(face.offset+i)*hw],u_send_buf[face.offset+i]);
+		}
+	      }
+	    }
+	    continue;
+	  }
+
+	  int mywork, myoff;
+	  GridThread::GetWork(face.words,me,mywork,myoff,nthreads);
+	  if ( face.splice ) {
+	    for(int i=0;i<Nsimd;i++){
+	      pointers[i] = &u_simd_send_buf[i][face.offset];
+	    }
+	  }
+	  for(int i=myoff;i<myoff+mywork;i++){
+	    int o  = (i/e2)*stride;
+	    int b  = i%e2;
+	    int ss = so+o+b;
+	    if ( face.splice ) {
+	      cobj temp = compress_me(rhs._odata[ss],dimension,plane,ss,_grid);
+	      extract<cobj>(temp,pointers,i);
+	      for(int l=0;l<Nsimd;l++){
+		if ( (face.pack>>l)&0x1 ) {
+		  PackHalf(&h_simd_send_buf[l][(face.offset+i)*hws],u_simd_send_buf[l][face.offset+i]);
+		}
+	      }
+	    } else {
+	      u_send_buf[face.offset+i] = compress_me(rhs._odata[ss],dimension,plane,ss,_grid);
+	      if ( face.pack ) {
+		PackHalf(&h_send_buf[(face.offset+i)*hw],u_send_buf[face.offset+i]);
 	      }
 	    }
 	  }
 	}
-	halotime+=usecond();
       }
 
-        void GatherStartComms(const Lattice<vobj> &rhs,int dimension,int shift,int cbmask,
-			      std::vector<cobj,alignedAllocator<cobj> > &u_comm_buf,
-			      int &u_comm_offset,compressor & compress)
+      // Messages are posted in the order tabulated; thread 0 only
+      void HaloExchangeStart(void)
+      {
+	commtime-=usecond();
+	for(int m=0;m<_messages.size();m++){
+	  Message &mm = _messages[m];
+	  CommsStart(mm.xmit,mm.xmit_to_rank,mm.recv,mm.recv_from_rank,mm.bytes);
+	}
+	commtime+=usecond();
+      }
+
+      void HaloExchangeWait(void)
+      {
+	if ( _posted ) {
+	  CommsPlan &plan = _plans[_plan];
+	  assert(plan.requests.size()==2*_posted);
+	  commtime-=usecond();
+	  _grid->SendToRecvFromComplete(plan.requests);
+	  commtime+=usecond();
+	  plan.built = 1;
+	  _posted    = 0;
+	}
+      }
+
+      // Share me of nthreads of every received face; binary16 lanes are widened
+      // element by element just before the merge that reads them.
+      void HaloMerge(int me,int nthreads)
+      {
+	const int hw  = HalfWords<cobj>();
+	const int hws = HalfWords<scalar_object>();
+	int mywork, myoff;
+	for(int u=0;u<_unpackers.size();u++){
+	  Unpack &uu = _unpackers[u];
+	  GridThread::GetWork(uu.buffer_size,me,mywork,myoff,nthreads);
+	  for(int i=myoff;i<myoff+mywork;i++){
+	    UnpackHalf(uu.cpointer[i],&uu.hpointer[i*hw]);
+	  }
+	}
+	for(int m=0;m<_mergers.size();m++){
+	  Merge &mm = _mergers[m];
+	  GridThread::GetWork(mm.buffer_size,me,mywork,myoff,nthreads);
+	  for(int i=myoff;i<myoff+mywork;i++){
+	    for(int l=0;l<mm.hpointers.size();l++){
+	      if ( mm.hpointers[l] ) UnpackHalf(mm.rpointers[l][i],&mm.hpointers[l][i*hws]);
+	    }
+	    merge(mm.mpointer[i],mm.rpointers,i);
+	  }
+	}
+      }
+
+      void HaloExchangeFinish(void)
+      {
+	_unpackers.resize(0);
+	_mergers.resize(0);
+      }
+
+      // Messages are posted in the same order by every exchange; the n'th one posted
+      // by a built plan restarts the n'th persistent pair.
+      void CommsStart(void *xmit,int xmit_to_rank,void *recv,int recv_from_rank,int bytes)
+      {
+	CommsPlan &plan = _plans[_plan];
+	if ( !plan.built ) {
+	  _grid->SendToRecvFromInit(plan.requests,xmit,xmit_to_rank,recv,recv_from_rank,bytes);
+	}
+	_grid->SendToRecvFromStart(plan.requests,_posted);
+	_posted++;
+      }
+
+      void TabulateMessage(void *xmit,int xmit_to_rank,void *recv,int recv_from_rank,int bytes)
+      {
+	Message m;
+	m.xmit           = xmit;
+	m.xmit_to_rank   = xmit_to_rank;
+	m.recv           = recv;
+	m.recv_from_rank = recv_from_rank;
+	m.bytes          = bytes;
+	_messages.push_back(m);
+      }
+
+        void TabulateComms(const Lattice<vobj> &rhs,int point,int dimension,int shift,int cbmask,
+			   std::vector<cobj,alignedAllocator<cobj> > &u_comm_buf,
+			   int &u_comm_offset,compressor & compress)
 	{
-	  typedef typename cobj::vector_type vector_type;
-	  typedef typename cobj::scalar_type scalar_type;
-	  
 	  GridBase *grid=_grid;
 	  assert(rhs._grid==_grid);
 	  //	  conformable(_grid,rhs._grid);
@@ -481,8 +819,6 @@ namespace Grid {
 
 	  int buffer_size = _grid->_slice_nblock[dimension]*_grid->_slice_block[dimension];
 
-	  if(send_buf.size()<buffer_size) send_buf.resize(buffer_size);
-
 	  int cb= (cbmask==0x2)? Odd : Even;
 	  int sshift= _grid->CheckerBoardShiftForCB(rhs.checkerboard,dimension,shift,cb);
 
@@ -498,9 +834,16 @@ namespace Grid {
 	    
 	      int bytes = words * sizeof(cobj);
 
-	      gathertime-=usecond();
-	      Gather_plane_simple (rhs,send_buf,dimension,sx,cbmask,compress);
-	      gathertime+=usecond();
+	      Face face;
+	      face.point     = point;
+	      face.dimension = dimension;
+	      face.plane     = sx;
+	      face.cbmask    = _grid->CheckerBoarded(dimension) ? cbmask : 0x3;
+	      face.offset    = u_comm_offset;
+	      face.words     = words;
+	      face.splice    = 0;
+	      face.pack      = compress.HalfPrecisionComms();
+	      _faces.push_back(face);
 
 	      int rank           = _grid->_processor;
 	      int recv_from_rank;
@@ -509,14 +852,27 @@ namespace Grid {
 	      assert (xmit_to_rank != _grid->ThisRank());
 	      assert (recv_from_rank != _grid->ThisRank());
 
-	      //      FIXME Implement asynchronous send & also avoid buffer copy
-	      commtime-=usecond();
-	      _grid->SendToRecvFrom((void *)&send_buf[0],
-				   xmit_to_rank,
-				    (void *)&u_comm_buf[u_comm_offset],
-				   recv_from_rank,
-				   bytes);
-	      commtime+=usecond();
+	      // Completed in HaloExchangeComplete
+	      if ( compress.HalfPrecisionComms() ) {
+		const int hw = HalfWords<cobj>();
+		TabulateMessage((void *)&h_send_buf[u_comm_offset*hw],
+				xmit_to_rank,
+				(void *)&h_recv_buf[u_comm_offset*hw],
+				recv_from_rank,
+				words*hw*sizeof(RealH));
+
+		Unpack u;
+		u.hpointer    = &h_recv_buf[u_comm_offset*hw];
+		u.buffer_size = words;
+		u.cpointer    = &u_comm_buf[u_comm_offset];
+		_unpackers.push_back(u);
+	      } else {
+		TabulateMessage((void *)&u_send_buf[u_comm_offset],
+				xmit_to_rank,
+				(void *)&u_comm_buf[u_comm_offset],
+				recv_from_rank,
+				bytes);
+	      }
 
 	      u_comm_offset+=words;
 	    }
@@ -524,11 +880,10 @@ namespace Grid {
 	}
 
 
-	void  GatherStartCommsSimd(const Lattice<vobj> &rhs,int dimension,int shift,int cbmask,
-				   std::vector<cobj,alignedAllocator<cobj> > &u_comm_buf,
-				   int &u_comm_offset,compressor &compress)
+	void  TabulateCommsSimd(const Lattice<vobj> &rhs,int point,int dimension,int shift,int cbmask,
+				std::vector<cobj,alignedAllocator<cobj> > &u_comm_buf,
+				int &u_comm_offset,compressor &compress)
 	{
-	  buftime-=usecond();
 	  const int Nsimd = _grid->Nsimd();
 
 	  
@@ -550,25 +905,15 @@ namespace Grid {
 	  // Simd direction uses an extract/merge pair
 	  ///////////////////////////////////////////////
 	  int buffer_size = _grid->_slice_nblock[dimension]*_grid->_slice_block[dimension];
-	  int words = sizeof(cobj)/sizeof(vector_type);
 
 	  assert(cbmask==0x3); // Fixme think there is a latent bug if not true
 
-	  //	Should grow to max size and then cost very little thereafter
-	  send_buf_extract.resize(Nsimd);
-	  recv_buf_extract.resize(Nsimd);
-	  for(int l=0;l<Nsimd;l++){
-	    if( send_buf_extract[l].size() < buffer_size) {
-	      send_buf_extract[l].resize(buffer_size);
-	      recv_buf_extract[l].resize(buffer_size);
-	    }
-	  }
-	  pointers.resize(Nsimd);
-	  rpointers.resize(Nsimd);
+	  std::vector<scalar_object *> rpointers(Nsimd);
+	  std::vector<RealH *>         hpointers;
+	  if ( compress.HalfPrecisionComms() ) hpointers.resize(Nsimd);
 
 	  int bytes = buffer_size*sizeof(scalar_object);
-	  
-	  buftime+=usecond();
+	  const int hw = HalfWords<scalar_object>();
 	  
 	  ///////////////////////////////////////////
 	  // Work out what to send where
@@ -584,15 +929,18 @@ namespace Grid {
 
 	    if ( any_offnode ) {
 
-	      for(int i=0;i<Nsimd;i++){       
-		pointers[i] = &send_buf_extract[i][0];
-	      }
 	      int sx   = (x+sshift)%rd;
-	      
-	      gathermtime-=usecond();
-	      Gather_plane_extract<cobj>(rhs,pointers,dimension,sx,cbmask,compress);
-	      gathermtime+=usecond();
 
+	      Face face;
+	      face.point     = point;
+	      face.dimension = dimension;
+	      face.plane     = sx;
+	      face.cbmask    = 0x3;
+	      face.offset    = u_comm_offset;
+	      face.words     = buffer_size;
+	      face.splice    = 1;
+	      face.pack      = 0;
+	      
 	      for(int i=0;i<Nsimd;i++){
 		
 
@@ -618,29 +966,39 @@ namespace Grid {
 		  
 		  _grid->ShiftedRanks(dimension,nbr_proc,xmit_to_rank,recv_from_rank); 
 		  
-		  commstime-=usecond();
-		  _grid->SendToRecvFrom((void *)&send_buf_extract[nbr_lane][0],
-					xmit_to_rank,
-					(void *)&recv_buf_extract[i][0],
-					recv_from_rank,
-					bytes);
-		  commstime+=usecond();
+		  if ( compress.HalfPrecisionComms() ) {
+		    face.pack |= 0x1<<nbr_lane;
+		    TabulateMessage((void *)&h_simd_send_buf[nbr_lane][u_comm_offset*hw],
+				    xmit_to_rank,
+				    (void *)&h_simd_recv_buf[i][u_comm_offset*hw],
+				    recv_from_rank,
+				    buffer_size*hw*sizeof(RealH));
+		    hpointers[i] = &h_simd_recv_buf[i][u_comm_offset*hw];
+		  } else {
+		    TabulateMessage((void *)&u_simd_send_buf[nbr_lane][u_comm_offset],
+				    xmit_to_rank,
+				    (void *)&u_simd_recv_buf[i][u_comm_offset],
+				    recv_from_rank,
+				    bytes);
+		  }
 		  
-		  rpointers[i] = &recv_buf_extract[i][0];
+		  rpointers[i] = &u_simd_recv_buf[i][u_comm_offset];
 
 		} else { 
-		  rpointers[i] = &send_buf_extract[nbr_lane][0];
+		  rpointers[i] = &u_simd_send_buf[nbr_lane][u_comm_offset];
+		  if ( hpointers.size() ) hpointers[i] = NULL;
 		}
 	      }
+	      _faces.push_back(face);
+
+	      // Here we don't want to scatter, just place into a buffer once the lanes arrive.
+	      Merge m;
+	      m.mpointer    = &u_comm_buf[u_comm_offset];
+	      m.rpointers   = rpointers;
+	      m.hpointers   = hpointers;
+	      m.buffer_size = buffer_size;
+	      _mergers.push_back(m);
 
-	      // Here we don't want to scatter, just place into a buffer.
-	      mergetime-=usecond();
-PARALLEL_FOR_LOOP
-	      for(int i=0;i<buffer_size;i++){
-		//		assert(u_comm_offset+i<_unified_buffer_size);
-		merge(u_comm_buf[u_comm_offset+i],rpointers,i);
-	      }
-	      mergetime+=usecond();
 	      u_comm_offset+=buffer_size;
 	    }
 	  }
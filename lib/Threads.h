@@ -7,6 +7,9 @@
 
 #define UNROLL  _Pragma("unroll")
 
+#include <atomic>
+#include <thread>
+
 #ifdef GRID_OMP
 #include <omp.h>
 #define PARALLEL_FOR_LOOP _Pragma("omp parallel for ")
@@ -26,6 +29,7 @@ class GridThread {
   static int _threads;
   static int _hyperthreads;
   static int _cores;
+  static int _comms_threads;
 
   static void SetCores(int cr) { 
 #ifdef GRID_OMP
@@ -51,6 +55,17 @@ class GridThread {
     _threads = 1;
 #endif
   };
+  // Threads 0.._comms_threads-1 of an overlapped Dslash share out gathers and merges
+  // while the others compute interior sites. Thread 0 is the master, so MPI is only
+  // ever called from it.
+  static void SetCommsThreads(int n) {
+#ifdef GRID_OMP
+    _comms_threads = n;
+#else
+    _comms_threads = 0;
+#endif
+  }
+  static int GetCommsThreads(void) { return _comms_threads; };
   static int GetHyperThreads(void) { assert(_threads%_cores ==0); return _threads/_cores; };
   static int GetCores(void)   { return _cores; };
   static int GetThreads(void) { return _threads; };
@@ -97,5 +112,27 @@ class GridThread {
 
 };
 
+// Barrier for threads 0..n-1 of a team while the others carry on; an omp barrier
+// would hold the whole team. Waiters yield, as the team may oversubscribe cores.
+class GridThreadBarrier {
+ public:
+  GridThreadBarrier(int n) : _n(n), _count(0), _generation(0) {};
+
+  void Wait(void) {
+    int generation = _generation.load();
+    if ( _count.fetch_add(1)+1 == _n ) {
+      _count = 0;
+      _generation++;
+    } else {
+      while ( _generation.load()==generation ) std::this_thread::yield();
+    }
+  }
+
+ private:
+  int _n;
+  std::atomic<int> _count;
+  std::atomic<int> _generation;
+};
+
 }
 #endif
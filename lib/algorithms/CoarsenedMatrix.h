@@ -175,6 +175,9 @@ namespace Grid {
     std::vector<CoarseMatrix> A;
 
     std::vector<siteVector,alignedAllocator<siteVector> >   comm_buf;
+
+    // Site traversal order of the stencil site tables (--lebesgue, --cacheblocking)
+    LebesgueOrder Lebesgue;
       
     ///////////////////////
     // Interface
@@ -187,10 +190,22 @@ namespace Grid {
       conformable(in._grid,out._grid);
 
       SimpleCompressor<siteVector> compressor;
-      Stencil.HaloExchange(in,comm_buf,compressor);
 
+      // Interior sites overlap the face exchange; the surface follows completion
+      Stencil.HaloExchangeBegin(in,comm_buf,compressor);
+      MSites(in,out,Stencil._interior_sites);
+      Stencil.HaloExchangeComplete();
+      MSites(in,out,Stencil._surface_sites);
+
+      return norm2(out);
+    };
+
+    // Applies the stencil on a site table, in its (possibly cache blocked) order
+    void MSites(const CoarseVector &in, CoarseVector &out,std::vector<int> &sites){
+      int nwork = sites.size();
 PARALLEL_FOR_LOOP
-      for(int ss=0;ss<Grid()->oSites();ss++){
+      for(int s=0;s<nwork;s++){
+	int ss = sites[s];
         siteVector res = zero;
 	siteVector nbr;
 	int ptype;
@@ -210,7 +225,6 @@ PARALLEL_FOR_LOOP
 	}
 	vstream(out._odata[ss],res);
       }
-      return norm2(out);
     };
 
     RealD Mdag (const CoarseVector &in, CoarseVector &out){ 
@@ -226,11 +240,26 @@ PARALLEL_FOR_LOOP
       _grid(&CoarseGrid),
       geom(CoarseGrid._ndimension),
       Stencil(&CoarseGrid,geom.npoint,Even,geom.directions,geom.displacements),
-      A(geom.npoint,&CoarseGrid)
+      A(geom.npoint,&CoarseGrid),
+      Lebesgue(&CoarseGrid,LebesgueBlock(&CoarseGrid))
     {
       comm_buf.resize(Stencil._unified_buffer_size);
+      if ( LebesgueOrder::UseLebesgueOrder ) Stencil.BuildSiteTables(1,&Lebesgue);
     };
 
+    // The 4d --cacheblocking block applies to the trailing dimensions; leading ones
+    // (the s-direction of a 5d coarse grid) are kept whole within a block
+    static std::vector<int> LebesgueBlock(GridBase *grid){
+      int ND    = grid->_ndimension;
+      int extra = ND-LebesgueOrder::Block.size();
+      std::vector<int> block(ND,0);
+      if ( LebesgueOrder::Block[0]==0 ) return block; // Z-graph
+      for(int d=0;d<ND;d++){
+	block[d] = (d<extra) ? grid->_rdimensions[d] : LebesgueOrder::Block[d-extra];
+      }
+      return block;
+    }
+
     void CoarsenOperator(GridBase *FineGrid,LinearOperatorBase<Lattice<Fobj> > &linop,
 			 Aggregation<Fobj,CComplex,nbasis> & Subspace){
 
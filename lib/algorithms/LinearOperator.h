@@ -195,22 +195,14 @@ namespace Grid {
       virtual  RealD Mpc      (const Field &in, Field &out) {
 	Field tmp(in._grid);
 
-	_Mat.Meooe(in,tmp);
-	_Mat.MooeeInv(tmp,out);
-	_Mat.Meooe(out,tmp);
-
-	_Mat.Mooee(in,out);
-	return axpy_norm(out,-1.0,tmp,out);
+	_Mat.MooeeInvMeooe(in,tmp,out,0);
+	return _Mat.MooeeMinusMeooe(in,tmp,out,0);
       }
       virtual  RealD MpcDag   (const Field &in, Field &out){
 	Field tmp(in._grid);
 
-	_Mat.MeooeDag(in,tmp);
-	_Mat.MooeeInvDag(tmp,out);
-	_Mat.MeooeDag(out,tmp);
-
-	_Mat.MooeeDag(in,out);
-	return axpy_norm(out,-1.0,tmp,out);
+	_Mat.MooeeInvMeooe(in,tmp,out,1);
+	return _Mat.MooeeMinusMeooe(in,tmp,out,1);
       }
     };
     template<class Matrix,class Field>
@@ -223,8 +215,7 @@ namespace Grid {
       virtual  RealD Mpc      (const Field &in, Field &out) {
 	Field tmp(in._grid);
 
-	_Mat.Meooe(in,tmp);
-	_Mat.MooeeInv(tmp,out);
+	_Mat.MooeeInvMeooe(in,out,tmp,0);
 	_Mat.Meooe(out,tmp);
 	_Mat.MooeeInv(tmp,out);
 
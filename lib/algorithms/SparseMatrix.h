@@ -38,6 +38,32 @@ namespace Grid {
       virtual  void MooeeDag    (const Field &in, Field &out)=0;
       virtual  void MooeeInvDag (const Field &in, Field &out)=0;
 
+      // Products the Schur operators are built from. An operator with a cheap diagonal
+      // can override these to apply it, the axpy and the norm within the hopping sweep.
+      //   out = MooeeInv Meooe in               (daggered throughout if dag)
+      //   out = Mooee in - Meooe x, returns |out|^2
+      // The composed defaults allocate nothing: the first works through the caller's
+      // scratch field, the second overwrites x.
+      virtual  void MooeeInvMeooe(const Field &in, Field &out,Field &scratch,int dag) {
+	if ( dag ) { 
+	  MeooeDag(in,scratch);
+	  MooeeInvDag(scratch,out);
+	} else { 
+	  Meooe(in,scratch);
+	  MooeeInv(scratch,out);
+	}
+      }
+      virtual RealD MooeeMinusMeooe(const Field &in,Field &x, Field &out,int dag) {
+	if ( dag ) { 
+	  MeooeDag(x,out);
+	  MooeeDag(in,x);
+	} else { 
+	  Meooe(x,out);
+	  Mooee(in,x);
+	}
+	return axpy_norm(out,-1.0,out,x);
+      }
+
     };
 
 }
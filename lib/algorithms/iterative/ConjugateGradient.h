@@ -19,6 +19,8 @@ public:
 
     void operator() (LinearOperatorBase<Field> &Linop,const Field &src, Field &psi){
 
+      AllocationCategory category("Solver");
+
       psi.checkerboard = src.checkerboard;
       conformable(psi,src);
 
@@ -48,6 +48,7 @@ void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector
 
 void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector<Field> &psi)
 {
+  AllocationCategory category("Solver");
   
   GridBase *grid = src._grid;
   
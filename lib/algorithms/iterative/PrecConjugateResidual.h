@@ -23,6 +23,8 @@ namespace Grid {
 
     void operator() (LinearOperatorBase<Field> &Linop,const Field &src, Field &psi){
 
+      AllocationCategory category("Solver");
+
       RealD a, b, c, d;
       RealD cp, ssq,rsq;
       
@@ -33,6 +33,8 @@ namespace Grid {
 
     void operator() (LinearOperatorBase<Field> &Linop,const Field &src, Field &psi){
 
+      AllocationCategory category("Solver");
+
       psi=zero;
       RealD cp, ssq,rsq;
       ssq=norm2(src);
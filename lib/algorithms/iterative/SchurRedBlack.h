@@ -58,6 +58,8 @@ namespace Grid {
     template<class Matrix>
       void operator() (Matrix & _Matrix,const Field &in, Field &out){
 
+      AllocationCategory category("Solver");
+
       // FIXME CGdiagonalMee not implemented virtual function
       // FIXME use CBfactorise to control schur decomp
       GridBase *grid = _Matrix.RedBlackGrid();
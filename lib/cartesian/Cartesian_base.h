@@ -140,6 +140,15 @@ public:
     inline int oSites(void) { return _osites; };
     inline int lSites(void) { return _isites*_osites; }; 
     inline int gSites(void) { return _isites*_osites*_Nprocessors; }; 
+
+    // Halo traffic on and off node for an object of bytes_per_site
+    void TopologyReport(int bytes_per_site) {
+      std::vector<double> face_bytes(_ndimension);
+      for(int d=0;d<_ndimension;d++){
+	face_bytes[d] = (double)bytes_per_site*lSites()/_ldimensions[d];
+      }
+      CartesianCommunicator::TopologyReport(face_bytes);
+    }
     inline int Nd    (void) { return _ndimension;};
 
     inline const std::vector<int> &FullDimensions(void)         { return _fdimensions;};
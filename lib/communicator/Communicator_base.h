@@ -19,7 +19,24 @@ class CartesianCommunicator {
     std::vector<int> _processor_coor;  // linear processor coordinate
     unsigned long _ndimension;
 
-#ifdef GRID_COMMS_MPI
+#if defined (GRID_COMMS_SHMEM)
+    MPI_Comm communicator;
+    // Peers on this node move halos through a shared segment; others use MPI.
+    struct CommsRequest_t {
+      MPI_Request req;
+      int   kind;     // ShmNone for an MPI request
+      int   peer;     // node local rank
+      void *buf;
+      int   bytes;
+      uint64_t seq;   // position of the message in the peer mailbox
+    };
+    enum { ShmNone, ShmSend, ShmRecv };
+    std::vector<int> _shm_ranks; // node local rank of each rank in communicator, or -1
+
+    void ShmInit(void);
+    static void ShmFinalize(void);
+    static uint64_t ShmBytes;    // per rank staging slab, --shm MB
+#elif defined (GRID_COMMS_MPI)
     MPI_Comm communicator;
     typedef MPI_Request CommsRequest_t;
 #else 
@@ -29,6 +46,19 @@ class CartesianCommunicator {
     // Constructor
     CartesianCommunicator(const std::vector<int> &pdimensions_in);
 
+    ////////////////////////////////////////////////////////////
+    // Topology. With --topology the ranks sharing a node take a
+    // block of the processor grid, chosen to keep the largest
+    // faces on node. The choice depends only on the processor
+    // grid, so 4d and 5d grids agree on every rank's coordinate.
+    ////////////////////////////////////////////////////////////
+    static int TopologyAware;
+    std::vector<int> _node_block; // processor grid block held by one node
+
+    // Sums the bytes sent on and off node in each dimension for the
+    // given bytes per face, over all ranks, and logs them.
+    void TopologyReport(const std::vector<double> &face_bytes);
+
     // Wraps MPI_Cart routines
     void ShiftedRanks(int dim,int shift,int & source, int & dest);
     int  RankFromProcessorCoor(std::vector<int> &coor);
@@ -103,6 +133,21 @@ class CartesianCommunicator {
 			 int bytes);
     void SendToRecvFromComplete(std::vector<CommsRequest_t> &waitall);
 
+    ////////////////////////////////////////////////////////////
+    // Persistent face exchange for fixed buffers, ranks and sizes.
+    // Init appends an inactive send and receive to the list; Start
+    // activates the i'th pair so appended; SendToRecvFromComplete
+    // waits and leaves the requests ready for the next Start.
+    ////////////////////////////////////////////////////////////
+    void SendToRecvFromInit(std::vector<CommsRequest_t> &list,
+			    void *xmit,
+			    int xmit_to_rank,
+			    void *recv,
+			    int recv_from_rank,
+			    int bytes);
+    void SendToRecvFromStart(std::vector<CommsRequest_t> &list,int i);
+    void SendToRecvFromFree(std::vector<CommsRequest_t> &list);
+
     ////////////////////////////////////////////////////////////
     // Barrier
     ////////////////////////////////////////////////////////////
@@ -5,6 +5,95 @@ namespace Grid {
 
   // Should error check all MPI calls.
 
+int CartesianCommunicator::TopologyAware;
+
+////////////////////////////////////////////////////////////////////////////
+// Pick the block of the processor grid that one node holds. A face in
+// dimension d is taken to scale as processors[d], i.e. a hypercubic global
+// lattice; a block spanning the whole dimension keeps its wrap on node too.
+////////////////////////////////////////////////////////////////////////////
+static void TopologySearch(const std::vector<int> &processors,int d,int remaining,
+			   std::vector<int> &block,std::vector<int> &best,double &best_cost)
+{
+  if ( d==processors.size() ) {
+    if ( remaining!=1 ) return;
+    double cost=0;
+    for(int mu=0;mu<processors.size();mu++){
+      if ( block[mu]<processors[mu] ) cost+= (double)processors[mu]/block[mu];
+    }
+    if ( cost < best_cost ) {
+      best_cost=cost;
+      best=block;
+    }
+    return;
+  }
+  for(int b=1;b<=processors[d];b++){
+    if ( (processors[d]%b==0) && (remaining%b==0) ) {
+      block[d]=b;
+      TopologySearch(processors,d+1,remaining/b,block,best,best_cost);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////
+// Reorder MPI_COMM_WORLD so that Cart rank order places each node's ranks
+// in one block; world rank 0 keeps coordinate zero. Returns 0, leaving
+// block empty, if node sizes differ or no block fits.
+////////////////////////////////////////////////////////////////////////////
+static int TopologyOrder(const std::vector<int> &processors,std::vector<int> &block,MPI_Comm &ordered)
+{
+  int ndim = processors.size();
+  int world_rank,world_size;
+  MPI_Comm_rank(MPI_COMM_WORLD,&world_rank);
+  MPI_Comm_size(MPI_COMM_WORLD,&world_size);
+
+  MPI_Comm node;
+  int node_rank,node_size;
+  MPI_Comm_split_type(MPI_COMM_WORLD,MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&node);
+  MPI_Comm_rank(node,&node_rank);
+  MPI_Comm_size(node,&node_size);
+
+  // Nodes are numbered in order of their lowest world rank
+  int leader = world_rank;
+  MPI_Bcast(&leader,1,MPI_INT,0,node);
+  MPI_Comm_free(&node);
+
+  std::vector<int> leaders(world_size);
+  MPI_Allgather(&leader,1,MPI_INT,&leaders[0],1,MPI_INT,MPI_COMM_WORLD);
+  int node_index=0;
+  int nodes=0;
+  for(int r=0;r<world_size;r++){
+    if ( leaders[r]==r ) {
+      if ( r<leader ) node_index++;
+      nodes++;
+    }
+  }
+
+  block.resize(0);
+  if ( nodes*node_size != world_size ) return 0;
+
+  std::vector<int> trial(ndim);
+  double cost=1.0e30;
+  TopologySearch(processors,0,node_size,trial,block,cost);
+  if ( block.size()==0 ) return 0;
+
+  std::vector<int> coor(ndim);
+  int n=node_index;
+  int l=node_rank;
+  for(int d=0;d<ndim;d++){
+    int nd = processors[d]/block[d];
+    coor[d] = (n%nd)*block[d] + l%block[d];
+    n/= nd;
+    l/= block[d];
+  }
+  // MPI_Cart ranks are row major
+  int key=0;
+  for(int d=0;d<ndim;d++) key = key*processors[d]+coor[d];
+
+  MPI_Comm_split(MPI_COMM_WORLD,0,key,&ordered);
+  return 1;
+}
+
 CartesianCommunicator::CartesianCommunicator(const std::vector<int> &processors)
 {
   _ndimension = processors.size();
@@ -13,8 +102,14 @@ CartesianCommunicator::CartesianCommunicator(const std::vector<int> &processors)
   _Nprocessors=1;
   _processors = processors;
   _processor_coor.resize(_ndimension);
-  
-  MPI_Cart_create(MPI_COMM_WORLD, _ndimension,&_processors[0],&periodic[0],1,&communicator);
+
+  MPI_Comm ordered;
+  if ( TopologyAware && TopologyOrder(_processors,_node_block,ordered) ) {
+    MPI_Cart_create(ordered, _ndimension,&_processors[0],&periodic[0],0,&communicator);
+    MPI_Comm_free(&ordered);
+  } else {
+    MPI_Cart_create(MPI_COMM_WORLD, _ndimension,&_processors[0],&periodic[0],1,&communicator);
+  }
   MPI_Comm_rank(communicator,&_processor);
   MPI_Cart_coords(communicator,_processor,_ndimension,&_processor_coor[0]);
 
@@ -26,6 +121,48 @@ CartesianCommunicator::CartesianCommunicator(const std::vector<int> &processors)
   MPI_Comm_size(communicator,&Size);
   
   assert(Size==_Nprocessors);
+
+#ifdef GRID_COMMS_SHMEM
+  ShmInit();
+#endif
+}
+
+void CartesianCommunicator::TopologyReport(const std::vector<double> &face_bytes)
+{
+  assert(face_bytes.size()==_ndimension);
+
+  MPI_Comm node;
+  MPI_Group cart_group,node_group;
+  MPI_Comm_split_type(communicator,MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&node);
+  MPI_Comm_group(communicator,&cart_group);
+  MPI_Comm_group(node,&node_group);
+
+  // on node bytes per dimension, then off node bytes
+  std::vector<double> bytes(2*_ndimension,0.0);
+  for(int d=0;d<_ndimension;d++){
+    if ( _processors[d]==1 ) continue;
+    int ranks[2];
+    int node_ranks[2];
+    ShiftedRanks(d,1,ranks[0],ranks[1]);
+    MPI_Group_translate_ranks(cart_group,2,ranks,node_group,node_ranks);
+    for(int i=0;i<2;i++){
+      if ( node_ranks[i]==MPI_UNDEFINED ) bytes[_ndimension+d]+=face_bytes[d];
+      else                                bytes[d]+=face_bytes[d];
+    }
+  }
+  MPI_Group_free(&cart_group);
+  MPI_Group_free(&node_group);
+  MPI_Comm_free(&node);
+
+  GlobalSumVector(&bytes[0],bytes.size());
+
+  std::cout<<GridLogMessage<<"Topology: processors "<<GridCmdVectorIntToString(_processors);
+  if ( _node_block.size() ) std::cout<<" node block "<<GridCmdVectorIntToString(_node_block);
+  std::cout<<std::endl;
+  for(int d=0;d<_ndimension;d++){
+    std::cout<<GridLogMessage<<"Topology: dim "<<d
+	     <<" on node "<<bytes[d]<<" bytes, off node "<<bytes[_ndimension+d]<<" bytes"<<std::endl;
+  }
 }
 
 void CartesianCommunicator::GlobalSum(uint32_t &u){
@@ -98,6 +235,7 @@ void CartesianCommunicator::SendTo(void *xmit,
   assert(ierr==0);
 }
 
+#ifndef GRID_COMMS_SHMEM
 // Basic Halo comms primitive
 void CartesianCommunicator::SendToRecvFromBegin(std::vector<CommsRequest_t> &list,
 						void *xmit,
@@ -127,6 +265,44 @@ void CartesianCommunicator::SendToRecvFromComplete(std::vector<CommsRequest_t> &
   assert(ierr==0);
 }
 
+void CartesianCommunicator::SendToRecvFromInit(std::vector<CommsRequest_t> &list,
+					       void *xmit,
+					       int dest,
+					       void *recv,
+					       int from,
+					       int bytes)
+{
+  MPI_Request xrq;
+  MPI_Request rrq;
+  int ierr;
+  ierr =MPI_Send_init(xmit, bytes, MPI_CHAR,dest,_processor,communicator,&xrq);
+  ierr|=MPI_Recv_init(recv, bytes, MPI_CHAR,from,from,communicator,&rrq);
+
+  assert(ierr==0);
+
+  list.push_back(xrq);
+  list.push_back(rrq);
+}
+void CartesianCommunicator::SendToRecvFromStart(std::vector<CommsRequest_t> &list,int i)
+{
+  assert(2*i+1<list.size());
+  int ierr = MPI_Startall(2,&list[2*i]);
+  assert(ierr==0);
+}
+void CartesianCommunicator::SendToRecvFromFree(std::vector<CommsRequest_t> &list)
+{
+  int finalized;
+  MPI_Finalized(&finalized);
+  if ( !finalized ) {
+    for(int r=0;r<list.size();r++){
+      int ierr = MPI_Request_free(&list[r]);
+      assert(ierr==0);
+    }
+  }
+  list.resize(0);
+}
+#endif
+
 void CartesianCommunicator::Barrier(void)
 {
   int ierr = MPI_Barrier(communicator);
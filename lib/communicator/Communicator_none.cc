@@ -16,6 +16,13 @@ CartesianCommunicator::CartesianCommunicator(const std::vector<int> &processors)
   }
 }
 
+int CartesianCommunicator::TopologyAware;
+
+void CartesianCommunicator::TopologyReport(const std::vector<double> &face_bytes)
+{
+  // Single rank: every face is local, nothing is sent
+}
+
 void CartesianCommunicator::GlobalSum(float &){}
 void CartesianCommunicator::GlobalSumVector(float *,int N){}
 void CartesianCommunicator::GlobalSum(double &){}
@@ -59,6 +66,24 @@ void CartesianCommunicator::SendToRecvFromComplete(std::vector<CommsRequest_t> &
   assert(0);
 }
 
+void CartesianCommunicator::SendToRecvFromInit(std::vector<CommsRequest_t> &list,
+					       void *xmit,
+					       int dest,
+					       void *recv,
+					       int from,
+					       int bytes)
+{
+  assert(0);
+}
+void CartesianCommunicator::SendToRecvFromStart(std::vector<CommsRequest_t> &list,int i)
+{
+  assert(0);
+}
+void CartesianCommunicator::SendToRecvFromFree(std::vector<CommsRequest_t> &list)
+{
+  list.resize(0);
+}
+
 void CartesianCommunicator::Barrier(void)
 {
 }
@@ -0,0 +1,320 @@
+#include "Grid.h"
+#include <mpi.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+
+////////////////////////////////////////////////////////////////////////////////////
+// Point to point transport for --enable-comms=shmem.
+//
+// Start up, reductions and ranks on other nodes use the MPI code. Ranks sharing a
+// node map one segment holding a mailbox for every ordered pair and a staging slab
+// per rank. A send copies into the sender's slab and publishes offset and length in
+// the pair mailbox; the receiver copies straight from that slab into its receive
+// buffer and acknowledges, so no message passes through the MPI library.
+//
+// Messages between a pair are matched in posting order, as MPI matches a fixed tag;
+// receives from one peer must also be completed in that order.
+//
+// The sends of one request list must fit the slab together; this is checked when
+// the list is built, naming the --shm size needed, rather than when a send is posted.
+////////////////////////////////////////////////////////////////////////////////////
+namespace Grid {
+
+#define SHM_RING (1024)
+
+struct ShmMailbox {
+  uint64_t sent;      // written by the sender only
+  char     pad0[56];
+  uint64_t consumed;  // written by the receiver only
+  char     pad1[56];
+  uint64_t offset[SHM_RING];
+  uint64_t bytes [SHM_RING];
+};
+
+uint64_t CartesianCommunicator::ShmBytes = 32*1024*1024;
+
+static MPI_Comm     ShmComm = MPI_COMM_NULL;
+static int          ShmRank;
+static int          ShmSize;
+static char *       ShmSegment;
+static size_t       ShmSegmentBytes;
+static ShmMailbox * ShmMailboxes;
+static char *       ShmSlabs;
+static uint64_t     ShmHeap;     // next free byte of this rank's slab
+static int          ShmInflight; // sends not yet acknowledged
+static std::vector<uint64_t> ShmPosted;   // receives posted, per source
+static std::vector<uint64_t> ShmReceived; // receives completed, per source
+
+static ShmMailbox & Mailbox(int from,int to) { return ShmMailboxes[from*ShmSize+to]; }
+
+static void ShmSetup(void)
+{
+  int ierr;
+  ierr = MPI_Comm_split_type(MPI_COMM_WORLD,MPI_COMM_TYPE_SHARED,0,MPI_INFO_NULL,&ShmComm);
+  assert(ierr==0);
+  MPI_Comm_rank(ShmComm,&ShmRank);
+  MPI_Comm_size(ShmComm,&ShmSize);
+
+  size_t header   = ShmSize*ShmSize*sizeof(ShmMailbox);
+  header          = (header+4095)&(~((size_t)4095));
+  ShmSegmentBytes = header + ShmSize*CartesianCommunicator::ShmBytes;
+
+  // Node leader creates the file; removed once every rank has it mapped
+  int pid = getpid();
+  MPI_Bcast(&pid,1,MPI_INT,0,ShmComm);
+  char name[256];
+  sprintf(name,"/dev/shm/Grid_shm_%d",pid);
+
+  int fd=-1;
+  if ( ShmRank==0 ) {
+    fd = open(name,O_RDWR|O_CREAT|O_TRUNC,0600);
+    assert(fd>=0);
+    ierr = ftruncate(fd,ShmSegmentBytes); // zero fill clears the mailboxes
+    assert(ierr==0);
+  }
+  MPI_Barrier(ShmComm);
+  if ( ShmRank!=0 ) {
+    fd = open(name,O_RDWR);
+    assert(fd>=0);
+  }
+  ShmSegment = (char *)mmap(NULL,ShmSegmentBytes,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+  assert(ShmSegment!=MAP_FAILED);
+  close(fd);
+  MPI_Barrier(ShmComm);
+  if ( ShmRank==0 ) unlink(name);
+
+  ShmMailboxes = (ShmMailbox *)ShmSegment;
+  ShmSlabs     = ShmSegment+header;
+  ShmHeap      = 0;
+  ShmInflight  = 0;
+  ShmPosted.resize(ShmSize,0);
+  ShmReceived.resize(ShmSize,0);
+}
+
+void CartesianCommunicator::ShmInit(void)
+{
+  if ( ShmComm == MPI_COMM_NULL ) ShmSetup();
+
+  MPI_Group cart_group;
+  MPI_Group shm_group;
+  MPI_Comm_group(communicator,&cart_group);
+  MPI_Comm_group(ShmComm,&shm_group);
+
+  std::vector<int> ranks(_Nprocessors);
+  for(int r=0;r<_Nprocessors;r++) ranks[r]=r;
+  _shm_ranks.resize(_Nprocessors);
+  int ierr=MPI_Group_translate_ranks(cart_group,_Nprocessors,&ranks[0],shm_group,&_shm_ranks[0]);
+  assert(ierr==0);
+  for(int r=0;r<_Nprocessors;r++){
+    if ( _shm_ranks[r]==MPI_UNDEFINED ) _shm_ranks[r]=-1;
+  }
+  MPI_Group_free(&cart_group);
+  MPI_Group_free(&shm_group);
+}
+
+void CartesianCommunicator::ShmFinalize(void)
+{
+  if ( ShmComm != MPI_COMM_NULL ) {
+    munmap(ShmSegment,ShmSegmentBytes);
+    MPI_Comm_free(&ShmComm);
+    ShmComm = MPI_COMM_NULL;
+  }
+}
+
+static uint64_t ShmRound(uint64_t bytes) { return (bytes+63)&(~((uint64_t)63)); }
+
+// Slab space needed by the sends of a list once one more of the given size is added
+static void ShmReserve(const std::vector<CartesianCommunicator::CommsRequest_t> &list,int bytes)
+{
+  uint64_t total = ShmRound(bytes);
+  for(int r=0;r<list.size();r++){
+    if ( list[r].kind == CartesianCommunicator::ShmSend ) total += ShmRound(list[r].bytes);
+  }
+  if ( total > CartesianCommunicator::ShmBytes ) {
+    uint64_t MB = (total+1024*1024-1)/(1024*1024);
+    std::cerr << "Shared memory halo exchange needs "<<MB<<" MB of staging per rank but the slab is "
+	      << CartesianCommunicator::ShmBytes/(1024*1024)<<" MB; run with --shm "<<MB<<" or more"<<std::endl;
+    assert(0);
+  }
+}
+
+// Only reached when request lists are interleaved; each list fits on its own, so once
+// the receivers have copied out every earlier send the slab can be reused from the start.
+static void ShmDrain(void)
+{
+  for(int p=0;p<ShmSize;p++){
+    ShmMailbox &mb = Mailbox(ShmRank,p);
+    while ( __atomic_load_n(&mb.consumed,__ATOMIC_ACQUIRE) < mb.sent ) sched_yield();
+  }
+  ShmHeap = 0;
+}
+
+static void ShmPost(CartesianCommunicator::CommsRequest_t &rq)
+{
+  if ( rq.kind == CartesianCommunicator::ShmSend ) {
+
+    ShmMailbox &mb = Mailbox(ShmRank,rq.peer);
+    uint64_t sent  = mb.sent;
+    uint64_t bytes = ShmRound(rq.bytes);
+    if ( ShmHeap+bytes > CartesianCommunicator::ShmBytes ) ShmDrain();
+    while ( sent-__atomic_load_n(&mb.consumed,__ATOMIC_ACQUIRE) >= SHM_RING ) sched_yield();
+
+    memcpy(ShmSlabs+ShmRank*CartesianCommunicator::ShmBytes+ShmHeap,rq.buf,rq.bytes);
+    mb.offset[sent%SHM_RING] = ShmHeap;
+    mb.bytes [sent%SHM_RING] = rq.bytes;
+    __atomic_store_n(&mb.sent,sent+1,__ATOMIC_RELEASE);
+
+    rq.seq   = sent;
+    ShmHeap += bytes;
+    ShmInflight++;
+
+  } else {
+    rq.seq = ShmPosted[rq.peer]++;
+  }
+}
+
+static void ShmComplete(std::vector<CartesianCommunicator::CommsRequest_t> &list)
+{
+  // Receives first; the peers may be waiting on our acknowledgement
+  for(int r=0;r<list.size();r++){
+    CartesianCommunicator::CommsRequest_t &rq = list[r];
+    if ( rq.kind != CartesianCommunicator::ShmRecv ) continue;
+
+    ShmMailbox &mb = Mailbox(rq.peer,ShmRank);
+    uint64_t seq   = rq.seq;
+    assert(seq==ShmReceived[rq.peer]);
+    while ( __atomic_load_n(&mb.sent,__ATOMIC_ACQUIRE) <= seq ) sched_yield();
+    assert(mb.bytes[seq%SHM_RING]==rq.bytes);
+
+    memcpy(rq.buf,ShmSlabs+rq.peer*CartesianCommunicator::ShmBytes+mb.offset[seq%SHM_RING],rq.bytes);
+    ShmReceived[rq.peer] = seq+1;
+    __atomic_store_n(&mb.consumed,seq+1,__ATOMIC_RELEASE);
+  }
+  for(int r=0;r<list.size();r++){
+    CartesianCommunicator::CommsRequest_t &rq = list[r];
+    if ( rq.kind != CartesianCommunicator::ShmSend ) continue;
+
+    ShmMailbox &mb = Mailbox(ShmRank,rq.peer);
+    while ( __atomic_load_n(&mb.consumed,__ATOMIC_ACQUIRE) <= rq.seq ) sched_yield();
+    ShmInflight--;
+  }
+  if ( ShmInflight==0 ) ShmHeap=0;
+}
+
+static CartesianCommunicator::CommsRequest_t ShmRequest(int kind,int peer,void *buf,int bytes)
+{
+  CartesianCommunicator::CommsRequest_t rq;
+  rq.req   = MPI_REQUEST_NULL;
+  rq.kind  = kind;
+  rq.peer  = peer;
+  rq.buf   = buf;
+  rq.bytes = bytes;
+  rq.seq   = 0;
+  return rq;
+}
+
+void CartesianCommunicator::SendToRecvFromBegin(std::vector<CommsRequest_t> &list,
+						void *xmit,
+						int dest,
+						void *recv,
+						int from,
+						int bytes)
+{
+  CommsRequest_t xrq = ShmRequest(ShmNone,_shm_ranks[dest],xmit,bytes);
+  CommsRequest_t rrq = ShmRequest(ShmNone,_shm_ranks[from],recv,bytes);
+  int ierr=0;
+
+  if ( xrq.peer>=0 ) {
+    ShmReserve(list,bytes);
+    xrq.kind = ShmSend;
+    ShmPost(xrq);
+  } else {
+    ierr|=MPI_Isend(xmit, bytes, MPI_CHAR,dest,_processor,communicator,&xrq.req);
+  }
+  if ( rrq.peer>=0 ) {
+    rrq.kind = ShmRecv;
+    ShmPost(rrq);
+  } else {
+    ierr|=MPI_Irecv(recv, bytes, MPI_CHAR,from,from,communicator,&rrq.req);
+  }
+  assert(ierr==0);
+
+  list.push_back(xrq);
+  list.push_back(rrq);
+}
+
+void CartesianCommunicator::SendToRecvFromComplete(std::vector<CommsRequest_t> &list)
+{
+  ShmComplete(list);
+
+  std::vector<MPI_Request> reqs;
+  for(int r=0;r<list.size();r++){
+    if ( list[r].kind==ShmNone ) reqs.push_back(list[r].req);
+  }
+  if ( reqs.size() ) {
+    std::vector<MPI_Status> status(reqs.size());
+    int ierr = MPI_Waitall(reqs.size(),&reqs[0],&status[0]);
+    assert(ierr==0);
+    int i=0;
+    for(int r=0;r<list.size();r++){
+      if ( list[r].kind==ShmNone ) list[r].req = reqs[i++];
+    }
+  }
+}
+
+void CartesianCommunicator::SendToRecvFromInit(std::vector<CommsRequest_t> &list,
+					       void *xmit,
+					       int dest,
+					       void *recv,
+					       int from,
+					       int bytes)
+{
+  CommsRequest_t xrq = ShmRequest(ShmNone,_shm_ranks[dest],xmit,bytes);
+  CommsRequest_t rrq = ShmRequest(ShmNone,_shm_ranks[from],recv,bytes);
+  int ierr=0;
+
+  if ( xrq.peer>=0 ) {
+    ShmReserve(list,bytes);
+    xrq.kind = ShmSend;
+  } else ierr|=MPI_Send_init(xmit, bytes, MPI_CHAR,dest,_processor,communicator,&xrq.req);
+
+  if ( rrq.peer>=0 ) rrq.kind = ShmRecv;
+  else ierr|=MPI_Recv_init(recv, bytes, MPI_CHAR,from,from,communicator,&rrq.req);
+
+  assert(ierr==0);
+
+  list.push_back(xrq);
+  list.push_back(rrq);
+}
+
+void CartesianCommunicator::SendToRecvFromStart(std::vector<CommsRequest_t> &list,int i)
+{
+  assert(2*i+1<list.size());
+  for(int r=2*i;r<2*i+2;r++){
+    if ( list[r].kind==ShmNone ) {
+      int ierr = MPI_Start(&list[r].req);
+      assert(ierr==0);
+    } else {
+      ShmPost(list[r]);
+    }
+  }
+}
+
+void CartesianCommunicator::SendToRecvFromFree(std::vector<CommsRequest_t> &list)
+{
+  int finalized;
+  MPI_Finalized(&finalized);
+  if ( !finalized ) {
+    for(int r=0;r<list.size();r++){
+      if ( (list[r].kind==ShmNone) && (list[r].req!=MPI_REQUEST_NULL) ) {
+	int ierr = MPI_Request_free(&list[r].req);
+	assert(ierr==0);
+      }
+    }
+  }
+  list.resize(0);
+}
+
+}
@@ -7,17 +7,67 @@ template<class vobj>
 class SimpleCompressor {
 public:
   void Point(int) {};
+  int HalfPrecisionComms(void) { return 0; };
 
   vobj operator() (const vobj &arg,int dimension,int plane,int osite,GridBase *grid) {
     return arg;
   }
 };
 
+///////////////////////////////////////////////////////////////////
+// Cshift communication buffers, kept per (grid, dimension) for each
+// object type so that repeated shifts allocate nothing once warm.
+// Buffers only grow; callers pass the word count they use rather than
+// relying on size(). Entries are keyed on the grid address and live for
+// the rest of the run; a face per dimension is small, and a grid
+// reallocated at the same address just reuses the entry. Get() may be
+// called from any thread, but a Cshift using the buffers is issued by
+// one thread at a time, as the communicators require.
+///////////////////////////////////////////////////////////////////
+template<class vobj>
+class CshiftBuffers {
+public:
+  typedef typename vobj::scalar_object scalar_object;
+
+  std::vector<vobj,alignedAllocator<vobj> > send_buf;
+  std::vector<vobj,alignedAllocator<vobj> > recv_buf;
+  std::vector<std::vector<scalar_object> >  send_buf_extract;
+  std::vector<std::vector<scalar_object> >  recv_buf_extract;
+
+  void Resize(int words) {
+    if ( (send_buf.size()<words) || (recv_buf.size()<words) ) {
+      static int category = AllocationPool::CategoryIndex("Cshift");
+      AllocationCategory scope(category);
+      if ( send_buf.size()<words ) send_buf.resize(words);
+      if ( recv_buf.size()<words ) recv_buf.resize(words);
+    }
+  }
+  void ResizeExtract(int Nsimd,int words) {
+    if ( send_buf_extract.size()<Nsimd ) send_buf_extract.resize(Nsimd);
+    if ( recv_buf_extract.size()<Nsimd ) recv_buf_extract.resize(Nsimd);
+    for(int l=0;l<Nsimd;l++){
+      if ( send_buf_extract[l].size()<words ) send_buf_extract[l].resize(words);
+      if ( recv_buf_extract[l].size()<words ) recv_buf_extract[l].resize(words);
+    }
+  }
+
+  // dimension -1 is used by the batched Cshift
+  static CshiftBuffers & Get(GridBase *grid,int dimension) {
+    static std::map<std::pair<GridBase *,int>,CshiftBuffers> cache;
+    CshiftBuffers *buffers;
+#pragma omp critical (GridCshiftBuffers)
+    {
+      buffers = &cache[std::make_pair(grid,dimension)];
+    }
+    return *buffers;
+  }
+};
+
 ///////////////////////////////////////////////////////////////////
 // Gather for when there is no need to SIMD split with compression
 ///////////////////////////////////////////////////////////////////
 template<class vobj,class cobj,class compressor> void 
-Gather_plane_simple (const Lattice<vobj> &rhs,std::vector<cobj,alignedAllocator<cobj> > &buffer,int dimension,int plane,int cbmask,compressor &compress)
+Gather_plane_simple (const Lattice<vobj> &rhs,std::vector<cobj,alignedAllocator<cobj> > &buffer,int dimension,int plane,int cbmask,compressor &compress,int off=0)
 {
   int rd = rhs._grid->_rdimensions[dimension];
 
@@ -36,7 +86,7 @@ PARALLEL_NESTED_LOOP2
       for(int b=0;b<e2;b++){
 	int o  = n*rhs._grid->_slice_stride[dimension];
 	int bo = n*rhs._grid->_slice_block[dimension];
-	buffer[bo+b]=compress(rhs._odata[so+o+b],dimension,plane,so+o+b,rhs._grid);
+	buffer[off+bo+b]=compress(rhs._odata[so+o+b],dimension,plane,so+o+b,rhs._grid);
       }
     }
   } else { 
@@ -46,7 +96,7 @@ PARALLEL_NESTED_LOOP2
 	 int o  = n*rhs._grid->_slice_stride[dimension];
 	 int ocb=1<<rhs._grid->CheckerBoardFromOindex(o+b);// Could easily be a table lookup
 	 if ( ocb &cbmask ) {
-	   buffer[bo++]=compress(rhs._odata[so+o+b],dimension,plane,so+o+b,rhs._grid);
+	   buffer[off+bo++]=compress(rhs._odata[so+o+b],dimension,plane,so+o+b,rhs._grid);
 	 }
        }
      }
@@ -105,10 +155,10 @@ PARALLEL_NESTED_LOOP2
 //////////////////////////////////////////////////////
 // Gather for when there is no need to SIMD split
 //////////////////////////////////////////////////////
-template<class vobj> void Gather_plane_simple (const Lattice<vobj> &rhs,std::vector<vobj,alignedAllocator<vobj> > &buffer,             int dimension,int plane,int cbmask)
+template<class vobj> void Gather_plane_simple (const Lattice<vobj> &rhs,std::vector<vobj,alignedAllocator<vobj> > &buffer,             int dimension,int plane,int cbmask,int off=0)
 {
   SimpleCompressor<vobj> dontcompress;
-  Gather_plane_simple (rhs,buffer,dimension,plane,cbmask,dontcompress);
+  Gather_plane_simple (rhs,buffer,dimension,plane,cbmask,dontcompress,off);
 }
 
 //////////////////////////////////////////////////////
@@ -123,7 +173,7 @@ template<class vobj> void Gather_plane_extract(const Lattice<vobj> &rhs,std::vec
 //////////////////////////////////////////////////////
 // Scatter for when there is no need to SIMD split
 //////////////////////////////////////////////////////
-template<class vobj> void Scatter_plane_simple (Lattice<vobj> &rhs,std::vector<vobj,alignedAllocator<vobj> > &buffer, int dimension,int plane,int cbmask)
+template<class vobj> void Scatter_plane_simple (Lattice<vobj> &rhs,std::vector<vobj,alignedAllocator<vobj> > &buffer, int dimension,int plane,int cbmask,int off=0)
 {
   int rd = rhs._grid->_rdimensions[dimension];
 
@@ -142,18 +192,17 @@ PARALLEL_NESTED_LOOP2
       for(int b=0;b<e2;b++){
 	int o   =n*rhs._grid->_slice_stride[dimension];
 	int bo  =n*rhs._grid->_slice_block[dimension];
-	rhs._odata[so+o+b]=buffer[bo+b];
+	rhs._odata[so+o+b]=buffer[off+bo+b];
       }
     }
   } else { 
-    int bo=0;
+    int bo=0; // packed contiguously, as in Gather_plane_simple
     for(int n=0;n<e1;n++){
       for(int b=0;b<e2;b++){
 	int o   =n*rhs._grid->_slice_stride[dimension];
-	int bo  =n*rhs._grid->_slice_block[dimension];
 	int ocb=1<<rhs._grid->CheckerBoardFromOindex(o+b);// Could easily be a table lookup
 	if ( ocb & cbmask ) {
-	  rhs._odata[so+o+b]=buffer[bo++];
+	  rhs._odata[so+o+b]=buffer[off+bo++];
 	}
       }
     }
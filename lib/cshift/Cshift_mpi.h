@@ -38,6 +38,224 @@ template<class vobj> Lattice<vobj> Cshift(const Lattice<vobj> &rhs,int dimension
   return ret;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////
+// Batched Cshift: ret[i] = Cshift(rhs[i],dimensions[i],shifts[i]).
+// Every off node face of every field is gathered and posted before any is waited on,
+// so the transfers for different fields and directions are in flight together.
+// Faces land in one cached send/recv buffer; planes are scattered after a single
+// completion. ret must be sized and on the grids of rhs.
+//////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj> void Cshift(std::vector<Lattice<vobj> > &ret,
+				 const std::vector<Lattice<vobj> > &rhs,
+				 const std::vector<int> &dimensions,
+				 const std::vector<int> &shifts)
+{
+  typedef typename vobj::scalar_object scalar_object;
+  typedef CartesianCommunicator::CommsRequest_t CommsRequest_t;
+
+  int N = rhs.size();
+  assert(ret.size()==N);
+  assert(dimensions.size()==N);
+  assert(shifts.size()==N);
+  if ( N==0 ) return;
+
+  // A face to scatter or, for SIMD split dimensions, a plane to merge
+  struct Face {
+    int field;
+    int plane;
+    int cbmask;
+    int offset;
+    std::vector<int> lane_from; // SIMD: lane buffer merged into each lane
+    std::vector<int> remote;    //       and whether it arrives in the recv buffer
+  };
+
+  ///////////////////////////////////////////
+  // Size the buffers for the whole batch
+  ///////////////////////////////////////////
+  int simple_words=0;
+  int simd_words=0;
+  int Nsimd=1;
+  for(int i=0;i<N;i++){
+    GridBase *grid = rhs[i]._grid;
+    int dimension  = dimensions[i];
+    int fd = grid->_fdimensions[dimension];
+    int rd = grid->_rdimensions[dimension];
+    int pd = grid->_processors[dimension];
+    int shift = (shifts[i]+fd)%fd;
+    if ( pd==1 ) continue;
+
+    int buffer_size = grid->_slice_nblock[dimension]*grid->_slice_block[dimension];
+    int sshift[2];
+    sshift[0] = grid->CheckerBoardShiftForCB(rhs[i].checkerboard,dimension,shift,Even);
+    sshift[1] = grid->CheckerBoardShiftForCB(rhs[i].checkerboard,dimension,shift,Odd);
+    int npass = (sshift[0]==sshift[1]) ? 1 : 2;
+
+    if ( grid->_simd_layout[dimension]>1 ) {
+      Nsimd = grid->Nsimd();
+      simd_words += npass*rd*buffer_size;
+    } else {
+      for(int p=0;p<npass;p++){
+	int words = (npass==1) ? buffer_size : buffer_size>>1;
+	for(int x=0;x<rd;x++){
+	  if ( ((x+sshift[p])/rd)%pd ) simple_words+=words;
+	}
+      }
+    }
+  }
+
+  CshiftBuffers<vobj> &buffers = CshiftBuffers<vobj>::Get(rhs[0]._grid,-1);
+  buffers.Resize(simple_words);
+  buffers.ResizeExtract(Nsimd,simd_words);
+  std::vector<vobj,alignedAllocator<vobj> > &send_buf = buffers.send_buf;
+  std::vector<vobj,alignedAllocator<vobj> > &recv_buf = buffers.recv_buf;
+  std::vector<std::vector<scalar_object> > &send_buf_extract = buffers.send_buf_extract;
+  std::vector<std::vector<scalar_object> > &recv_buf_extract = buffers.recv_buf_extract;
+
+  std::vector<CommsRequest_t> requests;
+  std::vector<Face> faces;
+  std::vector<Face> merges;
+  GridBase *comms_grid=NULL;
+  int simple_offset=0;
+  int simd_offset=0;
+
+  ///////////////////////////////////////////
+  // Gather and post everything
+  ///////////////////////////////////////////
+  for(int i=0;i<N;i++){
+
+    GridBase *grid = rhs[i]._grid;
+    conformable(ret[i]._grid,grid);
+    int dimension  = dimensions[i];
+    int fd = grid->_fdimensions[dimension];
+    int rd = grid->_rdimensions[dimension];
+    int ld = grid->_ldimensions[dimension];
+    int pd = grid->_processors[dimension];
+    int shift = (shifts[i]+fd)%fd;
+
+    ret[i].checkerboard = grid->CheckerBoardDestination(rhs[i].checkerboard,shift,dimension);
+
+    if ( pd==1 ) {
+      Cshift_local(ret[i],rhs[i],dimension,shift);
+      continue;
+    }
+    comms_grid = grid;
+
+    int buffer_size = grid->_slice_nblock[dimension]*grid->_slice_block[dimension];
+    int sshifts[2];
+    sshifts[0] = grid->CheckerBoardShiftForCB(rhs[i].checkerboard,dimension,shift,Even);
+    sshifts[1] = grid->CheckerBoardShiftForCB(rhs[i].checkerboard,dimension,shift,Odd);
+    int npass = (sshifts[0]==sshifts[1]) ? 1 : 2;
+
+    for(int p=0;p<npass;p++){
+
+      int cbmask = (npass==1) ? 0x3 : (p==0 ? 0x1 : 0x2);
+      int sshift = sshifts[p];
+
+      if ( grid->_simd_layout[dimension]>1 ) {
+
+	int permute_type=grid->PermuteType(dimension);
+	std::vector<scalar_object *> pointers(Nsimd);
+	int bytes = buffer_size*sizeof(scalar_object);
+
+	for(int x=0;x<rd;x++){
+
+	  int sx = (x+sshift)%rd;
+	  for(int l=0;l<Nsimd;l++) pointers[l] = &send_buf_extract[l][simd_offset];
+	  Gather_plane_extract(rhs[i],pointers,dimension,sx,cbmask);
+
+	  Face f;
+	  f.field  = i;
+	  f.plane  = x;
+	  f.cbmask = cbmask;
+	  f.offset = simd_offset;
+	  f.lane_from.resize(Nsimd);
+	  f.remote.resize(Nsimd);
+
+	  for(int l=0;l<Nsimd;l++){
+	    int inner_bit = (Nsimd>>(permute_type+1));
+	    int ic= (l&inner_bit)? 1:0;
+
+	    int my_coor  = rd*ic + x;
+	    int nbr_coor = my_coor+sshift;
+	    int nbr_proc = ((nbr_coor)/ld) % pd;
+	    int nbr_ic   = (nbr_coor%ld)/rd;
+	    int nbr_lane = (l&(~inner_bit));
+	    if (nbr_ic) nbr_lane|=inner_bit;
+
+	    f.lane_from[l] = nbr_lane;
+	    f.remote[l]    = nbr_proc;
+	    if ( nbr_proc ) {
+	      int recv_from_rank;
+	      int xmit_to_rank;
+	      grid->ShiftedRanks(dimension,nbr_proc,xmit_to_rank,recv_from_rank);
+	      grid->SendToRecvFromBegin(requests,
+					(void *)&send_buf_extract[nbr_lane][simd_offset],
+					xmit_to_rank,
+					(void *)&recv_buf_extract[l][simd_offset],
+					recv_from_rank,
+					bytes);
+	    }
+	  }
+	  merges.push_back(f);
+	  simd_offset+=buffer_size;
+	}
+
+      } else {
+
+	int words = (cbmask==0x3) ? buffer_size : buffer_size>>1;
+	int bytes = words*sizeof(vobj);
+
+	for(int x=0;x<rd;x++){
+	  int sx        = (x+sshift)%rd;
+	  int comm_proc = ((x+sshift)/rd)%pd;
+
+	  if ( comm_proc==0 ) {
+	    Copy_plane(ret[i],rhs[i],dimension,x,sx,cbmask);
+	  } else {
+	    Gather_plane_simple(rhs[i],send_buf,dimension,sx,cbmask,simple_offset);
+
+	    int recv_from_rank;
+	    int xmit_to_rank;
+	    grid->ShiftedRanks(dimension,comm_proc,xmit_to_rank,recv_from_rank);
+	    grid->SendToRecvFromBegin(requests,
+				      (void *)&send_buf[simple_offset],
+				      xmit_to_rank,
+				      (void *)&recv_buf[simple_offset],
+				      recv_from_rank,
+				      bytes);
+	    Face f;
+	    f.field  = i;
+	    f.plane  = x;
+	    f.cbmask = cbmask;
+	    f.offset = simple_offset;
+	    faces.push_back(f);
+	    simple_offset+=words;
+	  }
+	}
+      }
+    }
+  }
+
+  ///////////////////////////////////////////
+  // One completion, then scatter and merge
+  ///////////////////////////////////////////
+  if ( requests.size() ) comms_grid->SendToRecvFromComplete(requests);
+
+  for(int f=0;f<faces.size();f++){
+    Face &ff = faces[f];
+    Scatter_plane_simple(ret[ff.field],recv_buf,dimensions[ff.field],ff.plane,ff.cbmask,ff.offset);
+  }
+  std::vector<scalar_object *> rpointers(Nsimd);
+  for(int m=0;m<merges.size();m++){
+    Face &mm = merges[m];
+    for(int l=0;l<Nsimd;l++){
+      if ( mm.remote[l] ) rpointers[l] = &recv_buf_extract[l][mm.offset];
+      else                rpointers[l] = &send_buf_extract[mm.lane_from[l]][mm.offset];
+    }
+    Scatter_plane_merge(ret[mm.field],rpointers,dimensions[mm.field],mm.plane,mm.cbmask);
+  }
+}
+
 template<class vobj> void Cshift_comms(Lattice<vobj>& ret,const Lattice<vobj> &rhs,int dimension,int shift)
 {
   int sshift[2];
@@ -78,7 +296,6 @@ template<class vobj> void Cshift_comms(Lattice<vobj> &ret,const Lattice<vobj> &r
   typedef typename vobj::scalar_type scalar_type;
 
   GridBase *grid=rhs._grid;
-  Lattice<vobj> temp(rhs._grid);
 
   int fd              = rhs._grid->_fdimensions[dimension];
   int rd              = rhs._grid->_rdimensions[dimension];
@@ -91,8 +308,10 @@ template<class vobj> void Cshift_comms(Lattice<vobj> &ret,const Lattice<vobj> &r
   assert(shift<fd);
   
   int buffer_size = rhs._grid->_slice_nblock[dimension]*rhs._grid->_slice_block[dimension];
-  std::vector<vobj,alignedAllocator<vobj> > send_buf(buffer_size);
-  std::vector<vobj,alignedAllocator<vobj> > recv_buf(buffer_size);
+  CshiftBuffers<vobj> &buffers = CshiftBuffers<vobj>::Get(grid,dimension);
+  buffers.Resize(buffer_size);
+  std::vector<vobj,alignedAllocator<vobj> > &send_buf = buffers.send_buf;
+  std::vector<vobj,alignedAllocator<vobj> > &recv_buf = buffers.recv_buf;
 
   int cb= (cbmask==0x2)? Odd : Even;
   int sshift= rhs._grid->CheckerBoardShiftForCB(rhs.checkerboard,dimension,shift,cb);
@@ -108,7 +327,7 @@ template<class vobj> void Cshift_comms(Lattice<vobj> &ret,const Lattice<vobj> &r
 
     } else {
 
-      int words = send_buf.size();
+      int words = buffer_size;
       if (cbmask != 0x3) words=words>>1;
 
       int bytes = words * sizeof(vobj);
@@ -163,8 +382,10 @@ template<class vobj> void  Cshift_comms_simd(Lattice<vobj> &ret,const Lattice<vo
   int buffer_size = grid->_slice_nblock[dimension]*grid->_slice_block[dimension];
   int words = sizeof(vobj)/sizeof(vector_type);
 
-  std::vector<std::vector<scalar_object> > send_buf_extract(Nsimd,std::vector<scalar_object>(buffer_size) );
-  std::vector<std::vector<scalar_object> > recv_buf_extract(Nsimd,std::vector<scalar_object>(buffer_size) );
+  CshiftBuffers<vobj> &buffers = CshiftBuffers<vobj>::Get(grid,dimension);
+  buffers.ResizeExtract(Nsimd,buffer_size);
+  std::vector<std::vector<scalar_object> > &send_buf_extract = buffers.send_buf_extract;
+  std::vector<std::vector<scalar_object> > &recv_buf_extract = buffers.recv_buf_extract;
   int bytes = buffer_size*sizeof(scalar_object);
 
   std::vector<scalar_object *>  pointers(Nsimd);  // 
@@ -8,5 +8,19 @@ template<class vobj> Lattice<vobj> Cshift(const Lattice<vobj> &rhs,int dimension
   Cshift_local(ret,rhs,dimension,shift);
   return ret;
 }
+template<class vobj> void Cshift(std::vector<Lattice<vobj> > &ret,
+				 const std::vector<Lattice<vobj> > &rhs,
+				 const std::vector<int> &dimensions,
+				 const std::vector<int> &shifts)
+{
+  int N = rhs.size();
+  assert(ret.size()==N);
+  assert(dimensions.size()==N);
+  assert(shifts.size()==N);
+  for(int i=0;i<N;i++){
+    ret[i].checkerboard = rhs[i]._grid->CheckerBoardDestination(rhs[i].checkerboard,shifts[i],dimensions[i]);
+    Cshift_local(ret[i],rhs[i],dimensions[i],shifts[i]);
+  }
+}
 }
 #endif
@@ -69,6 +69,11 @@ public:
     int end(void)   { return _odata.size(); }
     vobj & operator[](int i) { return _odata[i]; };
 
+    // A moved from lattice keeps its grid but no payload; assignment sizes it again
+    strong_inline void Resize(void) {
+      if ( _odata.size() != _grid->oSites() ) _odata.resize(_grid->oSites());
+    }
+
 public:
     typedef typename vobj::scalar_type scalar_type;
     typedef typename vobj::vector_type vector_type;
@@ -90,6 +95,7 @@ public:
     assert( (cb==Odd) || (cb==Even));
     checkerboard=cb;
 
+    Resize();
 PARALLEL_FOR_LOOP
     for(int ss=0;ss<_grid->oSites();ss++){
 #ifdef STREAMING_STORES
@@ -113,6 +119,7 @@ PARALLEL_FOR_LOOP
     assert( (cb==Odd) || (cb==Even));
     checkerboard=cb;
 
+    Resize();
 PARALLEL_FOR_LOOP
     for(int ss=0;ss<_grid->oSites();ss++){
 #ifdef STREAMING_STORES
@@ -136,6 +143,7 @@ PARALLEL_FOR_LOOP
     assert( (cb==Odd) || (cb==Even));
     checkerboard=cb;
 
+    Resize();
 PARALLEL_FOR_LOOP
     for(int ss=0;ss<_grid->oSites();ss++){
 #ifdef STREAMING_STORES
@@ -220,7 +228,48 @@ PARALLEL_FOR_LOOP
         checkerboard=0;
     }
 
+    //////////////////////////////////////////////////////////////////
+    // Copy and move. Sizing _odata leaves it unset (the pool first
+    // touches fresh blocks with the site decomposition, see
+    // AllocationPool), so a copy fills the payload explicitly, in
+    // parallel. A move steals the payload of the source, leaving it
+    // empty; returning a Lattice by value from closure, operator / or a
+    // function costs no copy. The moved from lattice may only be
+    // assigned to or destroyed; every assignment resizes the payload
+    // first. Neither move throws, so std::vector<Lattice> growth moves.
+    //////////////////////////////////////////////////////////////////
+    Lattice(const Lattice<vobj> &r) : _grid(r._grid), checkerboard(r.checkerboard), _odata(r._odata.size()) {
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_odata.size();ss++){
+	_odata[ss]=r._odata[ss];
+      }
+    }
+    Lattice(Lattice<vobj> &&r) noexcept : _grid(r._grid), checkerboard(r.checkerboard), _odata(std::move(r._odata)) {
+    }
+
+    strong_inline Lattice<vobj> & operator = (const Lattice<vobj> &r){
+      if ( this == &r ) return *this;
+      _grid        = r._grid;
+      checkerboard = r.checkerboard;
+      if ( _odata.size() != r._odata.size() ) {
+	Vector<vobj> resized(r._odata.size());
+	_odata.swap(resized);
+      }
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_odata.size();ss++){
+	_odata[ss]=r._odata[ss];
+      }
+      return *this;
+    }
+    strong_inline Lattice<vobj> & operator = (Lattice<vobj> &&r) noexcept {
+      _grid        = r._grid;
+      checkerboard = r.checkerboard;
+      _odata       = std::move(r._odata);
+      return *this;
+    }
+
     template<class sobj> strong_inline Lattice<vobj> & operator = (const sobj & r){
+      Resize();
 PARALLEL_FOR_LOOP
         for(int ss=0;ss<_grid->oSites();ss++){
             this->_odata[ss]=r;
@@ -231,6 +280,7 @@ PARALLEL_FOR_LOOP
       this->checkerboard = r.checkerboard;
       conformable(*this,r);
       std::cout<<GridLogMessage<<"Lattice operator ="<<std::endl;
+      Resize();
 PARALLEL_FOR_LOOP
         for(int ss=0;ss<_grid->oSites();ss++){
             this->_odata[ss]=r._odata[ss];
@@ -238,19 +288,76 @@ PARALLEL_FOR_LOOP
         return *this;
     }
 
-    // *=,+=,-= operators inherit behvour from correspond */+/- operation
-    template<class T> strong_inline Lattice<vobj> &operator *=(const T &r) {
-        *this = (*this)*r;
-        return *this;
+    //////////////////////////////////////////////////////////////////
+    // *=,+=,-= have the meaning of the corresponding */+/- operation but
+    // are evaluated in place: one read-modify-write pass over _odata.
+    // Lattice and expression operands are evaluated site by site and
+    // their leaves must match the grid and checkerboard of the target;
+    // any other operand is a site or scalar object applied everywhere.
+    //////////////////////////////////////////////////////////////////
+    template<class T> using is_operand = std::integral_constant<bool,std::is_base_of<LatticeBase,T>::value||
+								      std::is_base_of<LatticeExpressionBase,T>::value>;
+
+    template<class T> strong_inline void ConformableOperand(const T &r) {
+      GridBase *egrid(nullptr);
+      GridFromExpression(egrid,r);
+      conformable(_grid,egrid);
+      int cb=checkerboard;
+      CBFromExpression(cb,r);
     }
 
-    template<class T> strong_inline Lattice<vobj> &operator -=(const T &r) {
-        *this = (*this)-r;
-        return *this;
+    template<class T,typename std::enable_if<is_operand<T>::value,T>::type * = nullptr>
+    strong_inline Lattice<vobj> &operator *=(const T &r) {
+      ConformableOperand(r);
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_grid->oSites();ss++){
+	_odata[ss]=_odata[ss]*eval(ss,r);
+      }
+      return *this;
     }
-    template<class T> strong_inline Lattice<vobj> &operator +=(const T &r) {
-        *this = (*this)+r;
-        return *this;
+    template<class T,typename std::enable_if<!is_operand<T>::value,T>::type * = nullptr>
+    strong_inline Lattice<vobj> &operator *=(const T &r) {
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_grid->oSites();ss++){
+	_odata[ss]=_odata[ss]*r;
+      }
+      return *this;
+    }
+
+    template<class T,typename std::enable_if<is_operand<T>::value,T>::type * = nullptr>
+    strong_inline Lattice<vobj> &operator -=(const T &r) {
+      ConformableOperand(r);
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_grid->oSites();ss++){
+	_odata[ss]=_odata[ss]-eval(ss,r);
+      }
+      return *this;
+    }
+    template<class T,typename std::enable_if<!is_operand<T>::value,T>::type * = nullptr>
+    strong_inline Lattice<vobj> &operator -=(const T &r) {
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_grid->oSites();ss++){
+	_odata[ss]=_odata[ss]-r;
+      }
+      return *this;
+    }
+
+    template<class T,typename std::enable_if<is_operand<T>::value,T>::type * = nullptr>
+    strong_inline Lattice<vobj> &operator +=(const T &r) {
+      ConformableOperand(r);
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_grid->oSites();ss++){
+	_odata[ss]=_odata[ss]+eval(ss,r);
+      }
+      return *this;
+    }
+    template<class T,typename std::enable_if<!is_operand<T>::value,T>::type * = nullptr>
+    strong_inline Lattice<vobj> &operator +=(const T &r) {
+PARALLEL_FOR_LOOP
+      for(int ss=0;ss<_grid->oSites();ss++){
+	_odata[ss]=_odata[ss]+r;
+      }
+      return *this;
     }
     
     strong_inline friend Lattice<vobj> operator / (const Lattice<vobj> &lhs,const Lattice<vobj> &rhs){
@@ -5,11 +5,17 @@ namespace Grid {
 namespace QCD {
 
     // These can move into a params header and be given MacroMagic serialisation
+    // halfprecision_comms sends the spin projected halo as binary16 with a per site scale
     struct GparityWilsonImplParams {
       std::vector<int> twists; 
+      bool halfprecision_comms;
+      GparityWilsonImplParams() : halfprecision_comms(false) {};
     };
 
-    struct WilsonImplParams { };
+    struct WilsonImplParams {
+      bool halfprecision_comms;
+      WilsonImplParams() : halfprecision_comms(false) {};
+    };
 
     struct OneFlavourRationalParams { 
       RealD  lo;
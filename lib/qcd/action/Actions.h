@@ -23,6 +23,7 @@
 #include <qcd/action/fermion/FermionOperatorImpl.h>
 #include <qcd/action/fermion/FermionOperator.h>
 #include <qcd/action/fermion/WilsonKernels.h>        //used by all wilson type fermions
+#include <qcd/action/fermion/DslashTuner.h>          //kernel and site order selection
 
 ////////////////////////////////////////////
 // Gauge Actions
@@ -56,6 +57,14 @@ typedef WilsonGaugeAction<LatticeGaugeFieldD>    WilsonGaugeActionD;
   template class A<GparityWilsonImplF>;		\
   template class A<GparityWilsonImplD>;		
 
+// Compressed link storage is provided for the 4d Wilson operators only
+#define FermOp4dTwoRowTemplateInstantiate(A) \
+  template class A<WilsonTwoRowImplF>;		\
+  template class A<WilsonTwoRowImplD>;		
+
+#define FermOp4dHalfTemplateInstantiate(A) \
+  template class A<WilsonHalfImplF>;		
+
 ////////////////////////////////////////////
 // Fermion operators / actions
 ////////////////////////////////////////////
@@ -63,6 +72,7 @@ typedef WilsonGaugeAction<LatticeGaugeFieldD>    WilsonGaugeActionD;
 #include <qcd/action/fermion/WilsonFermion.h>       // 4d wilson like
 #include <qcd/action/fermion/WilsonTMFermion.h>       // 4d wilson like
 #include <qcd/action/fermion/WilsonFermion5D.h>     // 5d base used by all 5d overlap types
+#include <qcd/action/fermion/WilsonMultiRHSFermion.h> // 4d wilson on a block of sources
 
 //#include <qcd/action/fermion/CloverFermion.h>
 
@@ -98,10 +108,20 @@ typedef WilsonFermion<WilsonImplR> WilsonFermionR;
 typedef WilsonFermion<WilsonImplF> WilsonFermionF;
 typedef WilsonFermion<WilsonImplD> WilsonFermionD;
 
+typedef WilsonFermion<WilsonTwoRowImplR> WilsonTwoRowFermionR;
+typedef WilsonFermion<WilsonTwoRowImplF> WilsonTwoRowFermionF;
+typedef WilsonFermion<WilsonTwoRowImplD> WilsonTwoRowFermionD;
+
+typedef WilsonFermion<WilsonHalfImplF> WilsonHalfFermionF;
+
 typedef WilsonTMFermion<WilsonImplR> WilsonTMFermionR;
 typedef WilsonTMFermion<WilsonImplF> WilsonTMFermionF;
 typedef WilsonTMFermion<WilsonImplD> WilsonTMFermionD;
 
+typedef WilsonMultiRHSFermion<WilsonImplR> WilsonMultiRHSFermionR;
+typedef WilsonMultiRHSFermion<WilsonImplF> WilsonMultiRHSFermionF;
+typedef WilsonMultiRHSFermion<WilsonImplD> WilsonMultiRHSFermionD;
+
 typedef DomainWallFermion<WilsonImplR> DomainWallFermionR;
 typedef DomainWallFermion<WilsonImplF> DomainWallFermionF;
 typedef DomainWallFermion<WilsonImplD> DomainWallFermionD;
@@ -18,42 +18,116 @@ namespace QCD {
  {
  }
 
+ ////////////////////////////////////////////////////////////////////////////////
+ // Fused s-direction kernels. All Ls slices of a 4d site are handled in one pass
+ // so each 5d field is streamed once, rather than once per slice and term.
+ //
+ // M5D:    chi[s] = diag[s] phi[s] + upper[s] P- psi[s+1] + lower[s] P+ psi[s-1]
+ // M5Ddag: chi[s] = diag[s] phi[s] + upper[s] P+ psi[s+1] + lower[s] P- psi[s-1]
+ //
+ // s+1 and s-1 wrap around; the mass dependence lives in upper[Ls-1] and lower[0].
+ // chi may alias phi but not psi.
+ ////////////////////////////////////////////////////////////////////////////////
+ template<class Impl>
+ void CayleyFermion5D<Impl>::M5D(const FermionField &psi,const FermionField &phi,FermionField &chi,
+				 std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper)
+ {
+   GridBase *grid=psi._grid;
+   int Ls=this->Ls;
+   assert(&chi != &psi);
+   chi.checkerboard=psi.checkerboard;
+   conformable(psi,phi);
+   conformable(psi,chi);
+PARALLEL_FOR_LOOP
+   for(int ss=0;ss<grid->oSites();ss+=Ls){ // adds Ls
+     for(int s=0;s<Ls;s++){
+       int sp = (s==Ls-1) ? 0    : s+1;
+       int sm = (s==0)    ? Ls-1 : s-1;
+       SiteSpinor tmp;
+       SiteSpinor pm;
+       SiteSpinor pp;
+       spProj5m(pm,psi._odata[ss+sp]);
+       spProj5p(pp,psi._odata[ss+sm]);
+       tmp = diag[s]*phi._odata[ss+s] + upper[s]*pm + lower[s]*pp;
+       vstream(chi._odata[ss+s],tmp);
+     }
+   }
+ }
+
+ template<class Impl>
+ void CayleyFermion5D<Impl>::M5Ddag(const FermionField &psi,const FermionField &phi,FermionField &chi,
+				    std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper)
+ {
+   GridBase *grid=psi._grid;
+   int Ls=this->Ls;
+   assert(&chi != &psi);
+   chi.checkerboard=psi.checkerboard;
+   conformable(psi,phi);
+   conformable(psi,chi);
+PARALLEL_FOR_LOOP
+   for(int ss=0;ss<grid->oSites();ss+=Ls){ // adds Ls
+     for(int s=0;s<Ls;s++){
+       int sp = (s==Ls-1) ? 0    : s+1;
+       int sm = (s==0)    ? Ls-1 : s-1;
+       SiteSpinor tmp;
+       SiteSpinor pp;
+       SiteSpinor pm;
+       spProj5p(pp,psi._odata[ss+sp]);
+       spProj5m(pm,psi._odata[ss+sm]);
+       tmp = diag[s]*phi._odata[ss+s] + upper[s]*pp + lower[s]*pm;
+       vstream(chi._odata[ss+s],tmp);
+     }
+   }
+ }
+
+ // M5D/M5Ddag coefficients for the s-matrix with diagonal b and hopping c,
+ // including the -mass wrap around terms
+ template<class Impl>
+ void CayleyFermion5D<Impl>::Coefficients5D(std::vector<RealD> &b,std::vector<RealD> &c,
+					    std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper)
+ {
+   int Ls=this->Ls;
+   lower.resize(Ls);
+   diag.resize(Ls);
+   upper.resize(Ls);
+   for(int s=0;s<Ls;s++){
+     diag[s] =b[s];
+     upper[s]=c[s];
+     lower[s]=c[s];
+   }
+   upper[Ls-1]=-mass*c[Ls-1];
+   lower[0]   =-mass*c[0];
+ }
+ template<class Impl>
+ void CayleyFermion5D<Impl>::Coefficients5Ddag(std::vector<RealD> &b,std::vector<RealD> &c,
+					       std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper)
+ {
+   int Ls=this->Ls;
+   lower.resize(Ls);
+   diag.resize(Ls);
+   upper.resize(Ls);
+   for(int s=0;s<Ls;s++){
+     diag[s] =b[s];
+     upper[s]=c[(s+1)%Ls];
+     lower[s]=c[(s+Ls-1)%Ls];
+   }
+   upper[Ls-1]=-mass*c[0];
+   lower[0]   =-mass*c[Ls-1];
+ }
+
  template<class Impl>
   void CayleyFermion5D<Impl>::Meooe5D    (const FermionField &psi, FermionField &Din)
   {
-    // Assemble Din
-    int Ls=this->Ls;
-    for(int s=0;s<Ls;s++){
-      if ( s==0 ) {
-	//	Din = bs psi[s] + cs[s] psi[s+1}
-	axpby_ssp_pminus(Din,bs[s],psi,cs[s],psi,s,s+1);
-	//      Din+= -mass*cs[s] psi[s+1}
-	axpby_ssp_pplus (Din,1.0,Din,-mass*cs[s],psi,s,Ls-1);
-      } else if ( s==(Ls-1)) { 
-	axpby_ssp_pminus(Din,bs[s],psi,-mass*cs[s],psi,s,0);
-	axpby_ssp_pplus (Din,1.0,Din,cs[s],psi,s,s-1);
-      } else {
-	axpby_ssp_pminus(Din,bs[s],psi,cs[s],psi,s,s+1);
-	axpby_ssp_pplus(Din,1.0,Din,cs[s],psi,s,s-1);
-      }
-    }
+    std::vector<RealD> lower,diag,upper;
+    Coefficients5D(bs,cs,lower,diag,upper);
+    M5D(psi,psi,Din,lower,diag,upper);
   }
  template<class Impl>
   void CayleyFermion5D<Impl>::MeooeDag5D    (const FermionField &psi, FermionField &Din)
   {
-    int Ls=this->Ls;
-    for(int s=0;s<Ls;s++){
-      if ( s==0 ) {
-	axpby_ssp_pplus (Din,bs[s],psi,cs[s+1],psi,s,s+1);
-	axpby_ssp_pminus(Din,1.0,Din,-mass*cs[Ls-1],psi,s,Ls-1);
-      } else if ( s==(Ls-1)) { 
-	axpby_ssp_pplus (Din,bs[s],psi,-mass*cs[0],psi,s,0);
-	axpby_ssp_pminus(Din,1.0,Din,cs[s-1],psi,s,s-1);
-      } else {
-	axpby_ssp_pplus (Din,bs[s],psi,cs[s+1],psi,s,s+1);
-	axpby_ssp_pminus(Din,1.0,Din,cs[s-1],psi,s,s-1);
-      }
-    }
+    std::vector<RealD> lower,diag,upper;
+    Coefficients5Ddag(bs,cs,lower,diag,upper);
+    M5Ddag(psi,psi,Din,lower,diag,upper);
   }
 
   // override multiply
@@ -65,41 +139,18 @@ namespace QCD {
     FermionField Din(psi._grid);
 
     // Assemble Din
-    /*
-    for(int s=0;s<Ls;s++){
-      if ( s==0 ) {
-	//	Din = bs psi[s] + cs[s] psi[s+1}
-	axpby_ssp_pminus(Din,bs[s],psi,cs[s],psi,s,s+1);
-	//      Din+= -mass*cs[s] psi[s+1}
-	axpby_ssp_pplus (Din,1.0,Din,-mass*cs[s],psi,s,Ls-1);
-      } else if ( s==(Ls-1)) { 
-	axpby_ssp_pminus(Din,bs[s],psi,-mass*cs[s],psi,s,0);
-	axpby_ssp_pplus (Din,1.0,Din,cs[s],psi,s,s-1);
-      } else {
-	axpby_ssp_pminus(Din,bs[s],psi,cs[s],psi,s,s+1);
-	axpby_ssp_pplus(Din,1.0,Din,cs[s],psi,s,s-1);
-      }
-    }
-    */
     Meooe5D(psi,Din);
 
     this->DW(Din,chi,DaggerNo);
     // ((b D_W + D_w hop terms +1) on s-diag
     axpby(chi,1.0,1.0,chi,psi); 
 
-    // Call Mooee??
-    for(int s=0;s<Ls;s++){
-      if ( s==0 ){
-	axpby_ssp_pminus(chi,1.0,chi,-1.0,psi,s,s+1);
-	axpby_ssp_pplus (chi,1.0,chi,mass,psi,s,Ls-1);
-      } else if ( s==(Ls-1)) {
-	axpby_ssp_pminus(chi,1.0,chi,mass,psi,s,0);
-	axpby_ssp_pplus (chi,1.0,chi,-1.0,psi,s,s-1);
-      } else {
-	axpby_ssp_pminus(chi,1.0,chi,-1.0,psi,s,s+1);
-	axpby_ssp_pplus (chi,1.0,chi,-1.0,psi,s,s-1);
-      }
-    }
+    // Terms independent of DW
+    std::vector<RealD> lower,diag,upper;
+    std::vector<RealD> one(Ls,1.0);
+    std::vector<RealD> mone(Ls,-1.0);
+    Coefficients5D(one,mone,lower,diag,upper);
+    M5D(psi,chi,chi,lower,diag,upper);
     return norm2(chi);
   }
 
@@ -110,45 +161,21 @@ namespace QCD {
     //D1+        D1- P-    ->   D1+^dag   P+ D2-^dag
     //D2- P+     D2+            P-D1-^dag D2+dag
 
+    int Ls=this->Ls;
+
     FermionField Din(psi._grid);
     // Apply Dw
     this->DW(psi,Din,DaggerYes); 
 
     MeooeDag5D(Din,chi);
 
-    int Ls=this->Ls;
-    for(int s=0;s<Ls;s++){
+    // Collect the terms indept of DW
+    std::vector<RealD> lower,diag,upper;
+    std::vector<RealD> one(Ls,1.0);
+    std::vector<RealD> mone(Ls,-1.0);
+    Coefficients5Ddag(one,mone,lower,diag,upper);
+    M5Ddag(psi,chi,chi,lower,diag,upper);
 
-      // Collect the terms in DW
-      //	Chi = bs Din[s] + cs[s] Din[s+1}
-      //    Chi+= -mass*cs[s] psi[s+1}
-      /*
-      if ( s==0 ) {
-	axpby_ssp_pplus (chi,bs[s],Din,cs[s+1],Din,s,s+1);
-	axpby_ssp_pminus(chi,1.0,chi,-mass*cs[Ls-1],Din,s,Ls-1);
-      } else if ( s==(Ls-1)) { 
-	axpby_ssp_pplus (chi,bs[s],Din,-mass*cs[0],Din,s,0);
-	axpby_ssp_pminus(chi,1.0,chi,cs[s-1],Din,s,s-1);
-      } else {
-	axpby_ssp_pplus (chi,bs[s],Din,cs[s+1],Din,s,s+1);
-	axpby_ssp_pminus(chi,1.0,chi,cs[s-1],Din,s,s-1);
-      }
-      */
-
-      // FIXME just call MooeeDag??
-
-      // Collect the terms indept of DW
-      if ( s==0 ){
-	axpby_ssp_pplus (chi,1.0,chi,-1.0,psi,s,s+1);
-	axpby_ssp_pminus(chi,1.0,chi,mass,psi,s,Ls-1);
-      } else if ( s==(Ls-1)) {
-	axpby_ssp_pplus (chi,1.0,chi,mass,psi,s,0);
-	axpby_ssp_pminus(chi,1.0,chi,-1.0,psi,s,s-1);
-      } else {
-	axpby_ssp_pplus(chi,1.0,chi,-1.0,psi,s,s+1);
-	axpby_ssp_pminus(chi,1.0,chi,-1.0,psi,s,s-1);
-      }
-    }
     // ((b D_W + D_w hop terms +1) on s-diag
     axpby (chi,1.0,1.0,chi,psi); 
     return norm2(chi);
@@ -227,18 +254,11 @@ namespace QCD {
   void CayleyFermion5D<Impl>::Mooee       (const FermionField &psi, FermionField &chi)
   {
     int Ls=this->Ls;
-    for (int s=0;s<Ls;s++){
-      if ( s==0 ) {
-	axpby_ssp_pminus(chi,bee[s],psi ,-cee[s],psi,s,s+1);
-	axpby_ssp_pplus (chi,1.0,chi,mass*cee[s],psi,s,Ls-1);
-      } else if ( s==(Ls-1)) { 
-	axpby_ssp_pminus(chi,bee[s],psi,mass*cee[s],psi,s,0);
-	axpby_ssp_pplus (chi,1.0,chi,-cee[s],psi,s,s-1);
-      } else {
-	axpby_ssp_pminus(chi,bee[s],psi,-cee[s],psi,s,s+1);
-	axpby_ssp_pplus (chi,1.0,chi,-cee[s],psi,s,s-1);
-      }
-    }
+    std::vector<RealD> lower,diag,upper;
+    std::vector<RealD> mcee(Ls);
+    for(int s=0;s<Ls;s++) mcee[s]=-cee[s];
+    Coefficients5D(bee,mcee,lower,diag,upper);
+    M5D(psi,psi,chi,lower,diag,upper);
   }
 
  template<class Impl>
@@ -246,20 +266,11 @@ namespace QCD {
     int Ls=this->Ls;
     FermionField tmp(psi._grid);
     // Assemble the 5d matrix
-    for(int s=0;s<Ls;s++){
-      if ( s==0 ) {
-	//	tmp = bs psi[s] + cs[s] psi[s+1}
-	//      tmp+= -mass*cs[s] psi[s+1}
-	axpby_ssp_pminus(tmp,beo[s],psi,-ceo[s],psi ,s, s+1);
-	axpby_ssp_pplus(tmp,1.0,tmp,mass*ceo[s],psi,s,Ls-1);
-      } else if ( s==(Ls-1)) { 
-	axpby_ssp_pminus(tmp,beo[s],psi,mass*ceo[s],psi,s,0);
-	axpby_ssp_pplus(tmp,1.0,tmp,-ceo[s],psi,s,s-1);
-      } else {
-	axpby_ssp_pminus(tmp,beo[s],psi,-ceo[s],psi,s,s+1);
-	axpby_ssp_pplus (tmp,1.0,tmp,-ceo[s],psi,s,s-1);
-      }
-    }
+    std::vector<RealD> lower,diag,upper;
+    std::vector<RealD> mceo(Ls);
+    for(int s=0;s<Ls;s++) mceo[s]=-ceo[s];
+    Coefficients5D(beo,mceo,lower,diag,upper);
+    M5D(psi,psi,tmp,lower,diag,upper);
     // Apply 4d dslash fragment
     this->DhopDir(tmp,chi,dir,disp);
   }
@@ -268,69 +279,93 @@ namespace QCD {
   void CayleyFermion5D<Impl>::MooeeDag    (const FermionField &psi, FermionField &chi)
   {
     int Ls=this->Ls;
-    for (int s=0;s<Ls;s++){
-      // Assemble the 5d matrix
-      if ( s==0 ) {
-	axpby_ssp_pplus(chi,bee[s],psi,-cee[s+1]  ,psi,s,s+1);
-	axpby_ssp_pminus(chi,1.0,chi,mass*cee[Ls-1],psi,s,Ls-1);
-      } else if ( s==(Ls-1)) { 
-	axpby_ssp_pplus(chi,bee[s],psi,mass*cee[0],psi,s,0);
-	axpby_ssp_pminus(chi,1.0,chi,-cee[s-1],psi,s,s-1);
-      } else {
-	axpby_ssp_pplus(chi,bee[s],psi,-cee[s+1],psi,s,s+1);
-	axpby_ssp_pminus(chi,1.0   ,chi,-cee[s-1],psi,s,s-1);
-      }
-    }
+    std::vector<RealD> lower,diag,upper;
+    std::vector<RealD> mcee(Ls);
+    for(int s=0;s<Ls;s++) mcee[s]=-cee[s];
+    Coefficients5Ddag(bee,mcee,lower,diag,upper);
+    M5Ddag(psi,psi,chi,lower,diag,upper);
   }
 
+  ////////////////////////////////////////////////////////////////////////////////
+  // LDU solve of the Ls x Ls tridiagonal (plus corners) ee matrix, one 4d site
+  // at a time so the whole s-column stays in cache through all the sweeps.
+  ////////////////////////////////////////////////////////////////////////////////
  template<class Impl>
   void CayleyFermion5D<Impl>::MooeeInv    (const FermionField &psi, FermionField &chi)
   {
+    GridBase *grid=psi._grid;
     int Ls=this->Ls;
-    // Apply (L^{\prime})^{-1}
-    axpby_ssp (chi,1.0,psi,     0.0,psi,0,0);      // chi[0]=psi[0]
-    for (int s=1;s<Ls;s++){
-      axpby_ssp_pplus(chi,1.0,psi,-lee[s-1],chi,s,s-1);// recursion Psi[s] -lee P_+ chi[s-1]
-    }
-    // L_m^{-1} 
-    for (int s=0;s<Ls-1;s++){ // Chi[ee] = 1 - sum[s<Ls-1] -leem[s]P_- chi
-      axpby_ssp_pminus(chi,1.0,chi,-leem[s],chi,Ls-1,s);
-    }
-    // U_m^{-1} D^{-1}
-    for (int s=0;s<Ls-1;s++){
-      // Chi[s] + 1/d chi[s] 
-      axpby_ssp_pplus(chi,1.0/dee[s],chi,-ueem[s]/dee[Ls-1],chi,s,Ls-1);
-    }	
-    axpby_ssp(chi,1.0/dee[Ls-1],chi,0.0,chi,Ls-1,Ls-1); // Modest avoidable 
-    
-    // Apply U^{-1}
-    for (int s=Ls-2;s>=0;s--){
-      axpby_ssp_pminus (chi,1.0,chi,-uee[s],chi,s,s+1);  // chi[Ls]
+    chi.checkerboard=psi.checkerboard;
+    conformable(psi,chi);
+
+PARALLEL_FOR_LOOP
+    for(int ss=0;ss<grid->oSites();ss+=Ls){ // adds Ls
+
+      SiteSpinor tmp;
+
+      // Apply (L^{\prime})^{-1}
+      chi._odata[ss]=psi._odata[ss];       // chi[0]=psi[0]
+      for(int s=1;s<Ls;s++){
+	spProj5p(tmp,chi._odata[ss+s-1]);   // recursion Psi[s] -lee P_+ chi[s-1]
+	chi._odata[ss+s] = psi._odata[ss+s] - lee[s-1]*tmp;
+      }
+      // L_m^{-1} 
+      for (int s=0;s<Ls-1;s++){ // Chi[ee] = 1 - sum[s<Ls-1] -leem[s]P_- chi
+	spProj5m(tmp,chi._odata[ss+s]);
+	chi._odata[ss+Ls-1] = chi._odata[ss+Ls-1] - leem[s]*tmp;
+      }
+      // U_m^{-1} D^{-1}
+      for (int s=0;s<Ls-1;s++){
+	// Chi[s] + 1/d chi[s] 
+	spProj5p(tmp,chi._odata[ss+Ls-1]);
+	chi._odata[ss+s] = (1.0/dee[s])*chi._odata[ss+s] - (ueem[s]/dee[Ls-1])*tmp;
+      }	
+      chi._odata[ss+Ls-1] = (1.0/dee[Ls-1])*chi._odata[ss+Ls-1];
+      
+      // Apply U^{-1}
+      for (int s=Ls-2;s>=0;s--){
+	spProj5m(tmp,chi._odata[ss+s+1]);
+	chi._odata[ss+s] = chi._odata[ss+s] - uee[s]*tmp;
+      }
     }
   }
 
  template<class Impl>
   void CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi, FermionField &chi)
   {
+    GridBase *grid=psi._grid;
     int Ls=this->Ls;
-    // Apply (U^{\prime})^{-dagger}
-    axpby_ssp (chi,1.0,psi,     0.0,psi,0,0);      // chi[0]=psi[0]
-    for (int s=1;s<Ls;s++){
-      axpby_ssp_pminus(chi,1.0,psi,-uee[s-1],chi,s,s-1);
-    }
-    // U_m^{-\dagger} 
-    for (int s=0;s<Ls-1;s++){
-      axpby_ssp_pplus(chi,1.0,chi,-ueem[s],chi,Ls-1,s);
-    }
-    // L_m^{-\dagger} D^{-dagger}
-    for (int s=0;s<Ls-1;s++){
-      axpby_ssp_pminus(chi,1.0/dee[s],chi,-leem[s]/dee[Ls-1],chi,s,Ls-1);
-    }	
-    axpby_ssp(chi,1.0/dee[Ls-1],chi,0.0,chi,Ls-1,Ls-1); // Modest avoidable 
+    chi.checkerboard=psi.checkerboard;
+    conformable(psi,chi);
+
+PARALLEL_FOR_LOOP
+    for(int ss=0;ss<grid->oSites();ss+=Ls){ // adds Ls
+
+      SiteSpinor tmp;
+
+      // Apply (U^{\prime})^{-dagger}
+      chi._odata[ss]=psi._odata[ss];       // chi[0]=psi[0]
+      for (int s=1;s<Ls;s++){
+	spProj5m(tmp,chi._odata[ss+s-1]);
+	chi._odata[ss+s] = psi._odata[ss+s] - uee[s-1]*tmp;
+      }
+      // U_m^{-\dagger} 
+      for (int s=0;s<Ls-1;s++){
+	spProj5p(tmp,chi._odata[ss+s]);
+	chi._odata[ss+Ls-1] = chi._odata[ss+Ls-1] - ueem[s]*tmp;
+      }
+      // L_m^{-\dagger} D^{-dagger}
+      for (int s=0;s<Ls-1;s++){
+	spProj5m(tmp,chi._odata[ss+Ls-1]);
+	chi._odata[ss+s] = (1.0/dee[s])*chi._odata[ss+s] - (leem[s]/dee[Ls-1])*tmp;
+      }	
+      chi._odata[ss+Ls-1] = (1.0/dee[Ls-1])*chi._odata[ss+Ls-1];
     
-    // Apply L^{-dagger}
-    for (int s=Ls-2;s>=0;s--){
-      axpby_ssp_pplus (chi,1.0,chi,-lee[s],chi,s,s+1);  // chi[Ls]
+      // Apply L^{-dagger}
+      for (int s=Ls-2;s>=0;s--){
+	spProj5p(tmp,chi._odata[ss+s+1]);
+	chi._odata[ss+s] = chi._odata[ss+s] - lee[s]*tmp;
+      }
     }
   }
 
@@ -36,6 +36,16 @@ namespace Grid {
       void   Meooe5D       (const FermionField &in, FermionField &out);
       void   MeooeDag5D    (const FermionField &in, FermionField &out);
 
+      // Fused s-direction kernels; one pass over the 5d field
+      void   M5D   (const FermionField &psi,const FermionField &phi,FermionField &chi,
+		    std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper);
+      void   M5Ddag(const FermionField &psi,const FermionField &phi,FermionField &chi,
+		    std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper);
+      void   Coefficients5D   (std::vector<RealD> &b,std::vector<RealD> &c,
+			       std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper);
+      void   Coefficients5Ddag(std::vector<RealD> &b,std::vector<RealD> &c,
+			       std::vector<RealD> &lower,std::vector<RealD> &diag,std::vector<RealD> &upper);
+
       //    protected:
       RealD mass;
 
@@ -0,0 +1,130 @@
+#include <Grid.h>
+#include <fstream>
+
+namespace Grid {
+namespace QCD {
+
+int DslashTuner::Enabled;
+int DslashTuner::Calls = 10;
+std::string DslashTuner::CacheFile("dslash.tune");
+std::vector<std::vector<int> > DslashTuner::Blocks({ {2,2,2,2}, {4,4,2,2}, {4,4,4,4} });
+
+// Decisions made or read by this process
+static std::map<std::string,DslashTuner::Choice> TunedCache;
+
+static std::string DottedVector(const std::vector<int> &vec)
+{
+  std::ostringstream oss;
+  for(int i=0;i<vec.size();i++){
+    if ( i ) oss<<".";
+    oss<<vec[i];
+  }
+  return oss.str();
+}
+
+std::string DslashTuner::BlockName(const std::vector<int> &block)
+{
+  if ( block.size()==0 ) return std::string("lex");
+  return DottedVector(block);
+}
+
+std::string DslashTuner::KernelName(int kernel)
+{
+  switch(kernel){
+  case Generic: return std::string("generic");
+  case Hand:    return std::string("hand");
+  case Asm:     return std::string("asm");
+  }
+  assert(0);
+  return std::string("");
+}
+
+std::string DslashTuner::Key(const std::string &op,GridBase *grid,int Ls)
+{
+  std::ostringstream oss;
+  oss<<op
+     <<" latt "   <<DottedVector(grid->_fdimensions)
+     <<" mpi "    <<DottedVector(grid->_processors)
+     <<" Ls "     <<Ls
+     <<" threads "<<GridThread::GetThreads();
+  return oss.str();
+}
+
+int DslashTuner::Lookup(GridBase *grid,const std::string &key,Choice &c)
+{
+  if ( TunedCache.find(key) != TunedCache.end() ) {
+    c = TunedCache[key];
+    return 1;
+  }
+
+  // found, kernel, block length, block[4]
+  int msg[7] = {0,0,0,0,0,0,0};
+  double usec = 0.0;
+
+  if ( grid->IsBoss() ) {
+    std::ifstream f(CacheFile.c_str());
+    std::string line;
+    // Later entries supersede earlier ones
+    while ( std::getline(f,line) ) {
+      size_t sep = line.find(" : ");
+      if ( (sep==std::string::npos) || (line.substr(0,sep)!=key) ) continue;
+
+      std::istringstream ss(line.substr(sep+3));
+      std::string name, blk;
+      double t;
+      if ( !(ss >> name >> blk >> t) ) continue;
+
+      int kernel=-1;
+      for(int k=Generic;k<=Asm;k++) if ( name==KernelName(k) ) kernel=k;
+      if ( kernel<0 ) continue;
+
+      std::vector<int> block;
+      if ( blk != "lex" ) {
+	std::istringstream bs(blk);
+	int b;
+	while ( bs >> b ) {
+	  block.push_back(b);
+	  if ( bs.peek()=='.' ) bs.ignore();
+	}
+      }
+      if ( (block.size()!=0) && (block.size()!=4) ) continue;
+
+      msg[0]=1;
+      msg[1]=kernel;
+      msg[2]=block.size();
+      for(int d=0;d<block.size();d++) msg[3+d] = block[d];
+      usec = t;
+    }
+  }
+  grid->Broadcast(0,(void *)msg,sizeof(msg));
+  grid->Broadcast(0,(void *)&usec,sizeof(usec));
+
+  if ( !msg[0] ) return 0;
+
+  c.kernel = msg[1];
+  c.block.resize(0);
+  if ( msg[2] ) c.block = std::vector<int>(&msg[3],&msg[3+msg[2]]);
+  c.usec   = usec;
+  TunedCache[key] = c;
+
+  std::cout<<GridLogMessage<<"DslashTuner cached "<<KernelName(c.kernel)<<" "<<BlockName(c.block)
+	   <<" for "<<key<<std::endl;
+  return 1;
+}
+
+void DslashTuner::Store(GridBase *grid,const std::string &key,const Choice &c)
+{
+  TunedCache[key] = c;
+
+  std::cout<<GridLogMessage<<"DslashTuner selected "<<KernelName(c.kernel)<<" "<<BlockName(c.block)
+	   <<" "<<c.usec<<" us for "<<key<<std::endl;
+
+  if ( grid->IsBoss() ) {
+    std::ofstream f(CacheFile.c_str(),std::ios::app);
+    f << key << " : " << KernelName(c.kernel) << " "
+      << BlockName(c.block) << " "
+      << c.usec << std::endl;
+  }
+}
+
+}}
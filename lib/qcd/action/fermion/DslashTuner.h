@@ -0,0 +1,104 @@
+#ifndef  GRID_QCD_DSLASH_TUNER_H
+#define  GRID_QCD_DSLASH_TUNER_H
+
+#include <typeinfo>
+
+namespace Grid {
+
+  namespace QCD {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Runtime selection of the Dslash kernel and site ordering (--dslash-tune).
+    //
+    // On first construction of a Wilson type operator for a given
+    // (operator/Impl, gauge geometry, decomposition, Ls, threads) every kernel is
+    // timed against every candidate cache blocking, and the fastest is kept for
+    // that operator and for any later operator with the same key. Decisions are
+    // appended to a cache file (--dslash-tune-file, default dslash.tune) which is
+    // read back on later runs, so tuning is paid once per machine and volume.
+    //
+    // Operators implement SetDslashVariant(kernel,block) and DhopOE; an empty
+    // block is lexicographic site order.
+    ////////////////////////////////////////////////////////////////////////////////
+    class DslashTuner {
+    public:
+
+      enum { Generic=0, Hand=1, Asm=2 };
+
+      struct Choice {
+	int kernel;
+	std::vector<int> block;
+	double usec;
+      };
+
+      static int Enabled;
+      static int Calls;                             // timed DhopOE calls per candidate
+      static std::string CacheFile;
+      static std::vector<std::vector<int> > Blocks; // cache blocking candidates
+
+      static std::string KernelName(int kernel);
+      static std::string BlockName(const std::vector<int> &block); // "lex" or "b0.b1.b2.b3"
+      static std::string Key(const std::string &op,GridBase *grid,int Ls);
+
+      // Collective; the boss rank reads the cache file and broadcasts the decision
+      static int  Lookup(GridBase *grid,const std::string &key,Choice &c);
+      static void Store (GridBase *grid,const std::string &key,const Choice &c);
+
+      template<class Op>
+      static void Tune(Op &op,int Ls,int nkernel)
+      {
+	typedef typename Op::FermionField FermionField;
+
+	GridBase *grid = op.FermionRedBlackGrid();
+	std::string key = Key(typeid(Op).name(),op.GaugeGrid(),Ls);
+
+	Choice best;
+	if ( Lookup(grid,key,best) ) {
+	  op.SetDslashVariant(best.kernel,best.block);
+	  return;
+	}
+
+	std::vector<std::vector<int> > blocks(1); // lexicographic
+	for(int b=0;b<Blocks.size();b++) blocks.push_back(Blocks[b]);
+	if ( LebesgueOrder::UseLebesgueOrder ) blocks.push_back(LebesgueOrder::Block);
+
+	FermionField in (grid); in =zero; in.checkerboard =Even;
+	FermionField out(grid); out=zero; out.checkerboard=Odd;
+
+	best.usec = -1.0;
+	for(int k=0;k<nkernel;k++){
+	  for(int b=0;b<blocks.size();b++){
+
+	    op.SetDslashVariant(k,blocks[b]);
+	    op.DhopOE(in,out,DaggerNo);
+
+	    grid->Barrier();
+	    double t0=usecond();
+	    for(int i=0;i<Calls;i++){
+	      op.DhopOE(in,out,DaggerNo);
+	    }
+	    double t1=usecond();
+
+	    // Every rank must reach the same decision
+	    double usec = (t1-t0)/Calls;
+	    grid->GlobalSum(usec);
+	    usec = usec/grid->ProcessorCount();
+
+	    std::cout<<GridLogPerformance<<"DslashTuner "<<KernelName(k)<<" "<<BlockName(blocks[b])
+		     <<" "<<usec<<" us"<<std::endl;
+	    if ( (best.usec<0) || (usec<best.usec) ) {
+	      best.kernel = k;
+	      best.block  = blocks[b];
+	      best.usec   = usec;
+	    }
+	  }
+	}
+
+	op.SetDslashVariant(best.kernel,best.block);
+	Store(grid,key,best);
+      }
+    };
+
+  }
+}
+#endif
@@ -27,6 +27,11 @@ namespace Grid {
     //    void ImportGauge(GridBase *GaugeGrid,DoubledGaugeField &Uds,const GaugeField &Umu)
     //    void DoubleStore(GridBase *GaugeGrid,DoubledGaugeField &Uds,const GaugeField &Umu)
     //    void multLink(SiteHalfSpinor &phi,const SiteDoubledGaugeField &U,const SiteHalfSpinor &chi,int mu,StencilEntry *SE,StencilImpl &St)
+    //    const SiteSpinor &loadSpinor(const FermionField &in,int ss,SiteSpinor &tmp)
+    //    void storeSpinor(FermionField &out,int ss,const SiteSpinor &r)
+    //    const void *spinorLines(const FermionField &in,int ss,int &bytes)
+    //    void KeepPacked(const FermionField &f,const std::vector<int> &faces)
+    //    void ReleasePacked(void)
     //    void InsertForce4D(GaugeField &mat,const FermionField &Btilde,const FermionField &A,int mu)
     //    void InsertForce5D(GaugeField &mat,const FermionField &Btilde,const FermionField &A,int mu)
     //
@@ -132,6 +137,16 @@ namespace Grid {
       ImplParams Params;
       WilsonImpl(const ImplParams &p= ImplParams()) : Params(p) {}; 
 
+      // Dhop reads and stores spinors as they are in the field; nothing is kept packed
+      inline const SiteSpinor &loadSpinor(const FermionField &in,int ss,SiteSpinor &tmp) { return in._odata[ss]; }
+      inline void storeSpinor(FermionField &out,int ss,const SiteSpinor &r) { vstream(out._odata[ss],r); }
+      inline const void *spinorLines(const FermionField &in,int ss,int &bytes) { 
+	bytes = sizeof(SiteSpinor);
+	return &in._odata[ss];
+      }
+      inline void KeepPacked(const FermionField &f,const std::vector<int> &faces) {};
+      inline void ReleasePacked(void) {};
+
       inline void multLink(SiteHalfSpinor &phi,const SiteDoubledGaugeField &U,const SiteHalfSpinor &chi,int mu,StencilEntry *SE,StencilImpl &St){
         mult(&phi(),&U(mu),&chi());
       }
@@ -175,6 +190,172 @@ PARALLEL_FOR_LOOP
 
     };
 
+    ////////////////////////////////////////////////////////////////////////////////////////
+    // Single flavour with compressed SU(3) links: the doubled gauge field keeps the first
+    // two rows (12 reals) of each link and multLink rebuilds the third as the conjugated
+    // cross product. Exact for SU(3) links only; trades 18 flops for 6 words per link.
+    ////////////////////////////////////////////////////////////////////////////////////////
+    template<class S,int Nrepresentation=Nc>
+    class WilsonTwoRowImpl :  public WilsonImpl<S,Nrepresentation> { 
+    public:
+
+      static_assert(Nrepresentation==3,"two row reconstruction requires SU(3)");
+
+      typedef WilsonImpl<S,Nrepresentation> Base;
+
+      INHERIT_GIMPL_TYPES(Base);
+
+      typedef typename Base::SiteHalfSpinor SiteHalfSpinor;
+      typedef typename Base::StencilImpl       StencilImpl;
+      typedef typename Base::ImplParams         ImplParams;
+
+      template<typename vtype> using iImplDoubledGaugeField  = iVector<iScalar<iVector<iVector<vtype, Nrepresentation>, 2> >, Nds >;
+    
+      typedef iImplDoubledGaugeField<Simd>    SiteDoubledGaugeField;
+      typedef Lattice<SiteDoubledGaugeField> DoubledGaugeField;
+
+      WilsonTwoRowImpl(const ImplParams &p= ImplParams()) : Base(p) {}; 
+
+      inline void multLink(SiteHalfSpinor &phi,const SiteDoubledGaugeField &U,const SiteHalfSpinor &chi,int mu,StencilEntry *SE,StencilImpl &St){
+	iScalar<iMatrix<Simd,Nrepresentation> > link;
+	const iVector<iVector<Simd,Nrepresentation>,2> &rows = U(mu)();
+	for(int c=0;c<Nrepresentation;c++){
+	  link()(0,c) = rows(0)(c);
+	  link()(1,c) = rows(1)(c);
+	}
+	link()(2,0) = conjugate(rows(0)(1)*rows(1)(2)-rows(0)(2)*rows(1)(1));
+	link()(2,1) = conjugate(rows(0)(2)*rows(1)(0)-rows(0)(0)*rows(1)(2));
+	link()(2,2) = conjugate(rows(0)(0)*rows(1)(1)-rows(0)(1)*rows(1)(0));
+        mult(&phi(),&link,&chi());
+      }
+
+      inline void DoubleStore(GridBase *GaugeGrid,DoubledGaugeField &Uds,const GaugeField &Umu)
+      {
+        conformable(Uds._grid,GaugeGrid);
+        conformable(Umu._grid,GaugeGrid);
+        GaugeLinkField U(GaugeGrid);
+        for(int mu=0;mu<Nd;mu++){
+  	  U = PeekIndex<LorentzIndex>(Umu,mu);
+	  StoreRows(Uds,U,mu);
+	  U = adj(Cshift(U,mu,-1));
+	  StoreRows(Uds,U,mu+4);
+	}
+      }
+
+      inline void StoreRows(DoubledGaugeField &Uds,const GaugeLinkField &U,int mu)
+      {
+PARALLEL_FOR_LOOP
+	for(int ss=0;ss<U._grid->oSites();ss++){
+	  for(int r=0;r<2;r++){
+	  for(int c=0;c<Nrepresentation;c++){
+	    Uds._odata[ss](mu)()(r)(c) = U._odata[ss]()()(r,c);
+	  }}
+	}
+      }
+
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////
+    // Single flavour with binary16 storage: each doubled gauge link is packed with its own
+    // scale and widened to S in multLink, so the kernels compute in the precision of S
+    // while reading half the link bytes. Fermion fields outside the operator stay in S so
+    // the solvers' linear algebra is unchanged; the MdagM intermediate, which nothing
+    // outside the operator sees, is kept in binary16 between its two sweeps. Intended as
+    // the inner operator of a defect correction.
+    ////////////////////////////////////////////////////////////////////////////////////////
+    template<class S,int Nrepresentation=Nc>
+    class WilsonHalfImpl :  public WilsonImpl<S,Nrepresentation> { 
+    public:
+
+      typedef WilsonImpl<S,Nrepresentation> Base;
+
+      INHERIT_GIMPL_TYPES(Base);
+
+      typedef typename Base::SiteSpinor         SiteSpinor;
+      typedef typename Base::SiteHalfSpinor SiteHalfSpinor;
+      typedef typename Base::FermionField     FermionField;
+      typedef typename Base::StencilImpl       StencilImpl;
+      typedef typename Base::ImplParams         ImplParams;
+
+      template<typename vtype> using iImplGaugeLink          = iScalar<iMatrix<vtype, Nrepresentation> >;
+    
+      typedef iImplGaugeLink <Simd>           SiteGaugeLink;
+      typedef iHalfStorage<SiteGaugeLink,Nds> SiteDoubledGaugeField;
+      typedef Lattice<SiteDoubledGaugeField> DoubledGaugeField;
+
+      WilsonHalfImpl(const ImplParams &p= ImplParams()) : Base(p), PackedFacesFrom(NULL), PackedField(NULL) {}; 
+
+      // KeepPacked(f) makes the sweeps that store f write it in binary16, with one scale
+      // per site object, and in S only at the face sites the halo exchange gathers from;
+      // the sweeps that read f then widen it like the links, until ReleasePacked
+      typedef iHalfStorage<SiteSpinor,1> SitePackedSpinor;
+      Vector<SitePackedSpinor> PackedSpinors;
+      std::vector<char>        PackedFaces;
+      const std::vector<int>  *PackedFacesFrom;
+      const FermionField      *PackedField;
+
+      inline void KeepPacked(const FermionField &f,const std::vector<int> &faces) {
+	int nsite = f._odata.size();
+	if ( PackedSpinors.size() < nsite ) PackedSpinors.resize(nsite);
+	if ( (PackedFacesFrom != &faces) || (PackedFaces.size() != nsite) ) {
+	  PackedFaces.assign(nsite,0);
+	  for(int i=0;i<faces.size();i++) PackedFaces[faces[i]]=1;
+	  PackedFacesFrom = &faces; // reordering a site table keeps the set of face sites
+	}
+	PackedField = &f;
+      }
+      inline void ReleasePacked(void) { PackedField = NULL; };
+
+      inline const SiteSpinor &loadSpinor(const FermionField &in,int ss,SiteSpinor &tmp) {
+	if ( &in != PackedField ) return in._odata[ss];
+	PackedSpinors[ss].unpack(0,tmp);
+	return tmp;
+      }
+      inline void storeSpinor(FermionField &out,int ss,const SiteSpinor &r) {
+	if ( &out == PackedField ) {
+	  PackedSpinors[ss].pack(0,r);
+	  if ( !PackedFaces[ss] ) return;
+	}
+	vstream(out._odata[ss],r);
+      }
+      inline const void *spinorLines(const FermionField &in,int ss,int &bytes) { 
+	if ( &in != PackedField ) { 
+	  bytes = sizeof(SiteSpinor);
+	  return &in._odata[ss];
+	}
+	bytes = sizeof(SitePackedSpinor);
+	return &PackedSpinors[ss];
+      }
+
+      inline void multLink(SiteHalfSpinor &phi,const SiteDoubledGaugeField &U,const SiteHalfSpinor &chi,int mu,StencilEntry *SE,StencilImpl &St){
+	SiteGaugeLink link;
+	U.unpack(mu,link);
+        mult(&phi(),&link,&chi());
+      }
+
+      inline void DoubleStore(GridBase *GaugeGrid,DoubledGaugeField &Uds,const GaugeField &Umu)
+      {
+        conformable(Uds._grid,GaugeGrid);
+        conformable(Umu._grid,GaugeGrid);
+        GaugeLinkField U(GaugeGrid);
+        for(int mu=0;mu<Nd;mu++){
+  	  U = PeekIndex<LorentzIndex>(Umu,mu);
+	  StoreHalf(Uds,U,mu);
+	  U = adj(Cshift(U,mu,-1));
+	  StoreHalf(Uds,U,mu+4);
+	}
+      }
+
+      inline void StoreHalf(DoubledGaugeField &Uds,const GaugeLinkField &U,int mu)
+      {
+PARALLEL_FOR_LOOP
+	for(int ss=0;ss<U._grid->oSites();ss++){
+	  Uds._odata[ss].pack(mu,U._odata[ss]());
+	}
+      }
+
+    };
+
     ////////////////////////////////////////////////////////////////////////////////////////
     // Flavour doubled spinors; is Gparity the only? what about C*?
     ////////////////////////////////////////////////////////////////////////////////////////
@@ -204,6 +385,16 @@ PARALLEL_FOR_LOOP
       typedef GparityWilsonImplParams ImplParams;
       ImplParams Params;
       GparityWilsonImpl(const ImplParams &p= ImplParams()) : Params(p) {}; 
+
+      // Dhop reads and stores spinors as they are in the field; nothing is kept packed
+      inline const SiteSpinor &loadSpinor(const FermionField &in,int ss,SiteSpinor &tmp) { return in._odata[ss]; }
+      inline void storeSpinor(FermionField &out,int ss,const SiteSpinor &r) { vstream(out._odata[ss],r); }
+      inline const void *spinorLines(const FermionField &in,int ss,int &bytes) { 
+	bytes = sizeof(SiteSpinor);
+	return &in._odata[ss];
+      }
+      inline void KeepPacked(const FermionField &f,const std::vector<int> &faces) {};
+      inline void ReleasePacked(void) {};
       
 
       // provide the multiply by link that is differentiated between Gparity (with flavour index) and non-Gparity
@@ -370,6 +561,12 @@ PARALLEL_FOR_LOOP
     typedef WilsonImpl<vComplexF,Nc> WilsonImplF; // Float
     typedef WilsonImpl<vComplexD,Nc> WilsonImplD; // Double
 
+    typedef WilsonTwoRowImpl<vComplex ,Nc> WilsonTwoRowImplR; // Real.. whichever prec
+    typedef WilsonTwoRowImpl<vComplexF,Nc> WilsonTwoRowImplF; // Float
+    typedef WilsonTwoRowImpl<vComplexD,Nc> WilsonTwoRowImplD; // Double
+
+    typedef WilsonHalfImpl<vComplexF,Nc> WilsonHalfImplF; // Float arithmetic, binary16 links and Dhop input
+
     typedef GparityWilsonImpl<vComplex ,Nc> GparityWilsonImplR; // Real.. whichever prec
     typedef GparityWilsonImpl<vComplexF,Nc> GparityWilsonImplF; // Float
     typedef GparityWilsonImpl<vComplexD,Nc> GparityWilsonImplD; // Double
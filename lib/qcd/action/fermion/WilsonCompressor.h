@@ -9,12 +9,17 @@ namespace QCD {
   public:
     int mu;
     int dag;
+    int half;
 
-    WilsonCompressor(int _dag){
+    WilsonCompressor(int _dag,int _half=0){
       mu=0;
       dag=_dag;
+      half=_half;
       assert((dag==0)||(dag==1));
     }
+    // Stencil narrows the projected halo to binary16 on the wire
+    int HalfPrecisionComms(void) { return half; };
+
     void Point(int p) { 
       mu=p;
     };
@@ -27,7 +32,7 @@ namespace QCD {
     {
       SiteHalfSpinor ret;
       int mudag=mu;
-      if (dag) {
+      if (!dag) {
 	mudag=(mu+Nd)%(2*Nd);
       }
       switch(mudag) {
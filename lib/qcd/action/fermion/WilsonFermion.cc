@@ -25,11 +25,54 @@ namespace QCD {
 	mass(_mass),
 	Umu(&Fgrid),
 	UmuEven(&Hgrid),
-	UmuOdd (&Hgrid) 
+	UmuOdd (&Hgrid),
+	Lebesgue(&Fgrid),
+	LebesgueEvenOdd(&Hgrid),
+	TunedKernel(-1)
   {
+    // Doubled links were built in the initialiser list; charge them to the action
+    AllocationPool::Attribute(&Umu._odata[0]    ,"Fermion");
+    AllocationPool::Attribute(&UmuEven._odata[0],"Fermion");
+    AllocationPool::Attribute(&UmuOdd._odata[0] ,"Fermion");
+
     // Allocate the required comms buffer
-    comm_buf.resize(Stencil._unified_buffer_size); // this is always big enough to contain EO
+    {
+      AllocationCategory category("Stencil");
+      comm_buf.resize(Stencil._unified_buffer_size); // this is always big enough to contain EO
+    }
+
+    int lebesgue = LebesgueOrder::UseLebesgueOrder;
+    Stencil.BuildSiteTables(1,lebesgue ? &Lebesgue : NULL);
+    StencilEven.BuildSiteTables(1,lebesgue ? &LebesgueEvenOdd : NULL);
+    StencilOdd.BuildSiteTables(1,lebesgue ? &LebesgueEvenOdd : NULL);
+
     ImportGauge(_Umu);
+
+    if ( DslashTuner::Enabled ) DslashTuner::Tune(*this,1,2);
+  }
+
+  template<class Impl>
+  void WilsonFermion<Impl>::SetDslashVariant(int kernel,const std::vector<int> &block)
+  {
+    TunedKernel = kernel;
+    if ( block.size() ) {
+      Lebesgue        = LebesgueOrder(_grid,block);
+      LebesgueEvenOdd = LebesgueOrder(_cbgrid,block);
+      Stencil.BuildSiteTables(1,&Lebesgue);
+      StencilEven.BuildSiteTables(1,&LebesgueEvenOdd);
+      StencilOdd.BuildSiteTables(1,&LebesgueEvenOdd);
+    } else {
+      Stencil.BuildSiteTables(1);
+      StencilEven.BuildSiteTables(1);
+      StencilOdd.BuildSiteTables(1);
+    }
+  }
+
+  template<class Impl>
+  int WilsonFermion<Impl>::DslashKernel(void)
+  {
+    if ( TunedKernel >= 0 ) return TunedKernel;
+    return HandOptDslash ? DslashTuner::Hand : DslashTuner::Generic;
   }
 
   template<class Impl>
@@ -48,16 +91,30 @@ namespace QCD {
   RealD WilsonFermion<Impl>::M(const FermionField &in, FermionField &out) 
   {
     out.checkerboard=in.checkerboard;
+    this->EpilogueBegin(1.0,4+mass,&in,1);
     Dhop(in,out,DaggerNo);
-    return axpy_norm(out,4+mass,in,out);
+    return this->EpilogueEnd(out._grid);
   }
 
   template<class Impl>
   RealD WilsonFermion<Impl>::Mdag(const FermionField &in, FermionField &out) 
   {
     out.checkerboard=in.checkerboard;
+    this->EpilogueBegin(1.0,4+mass,&in,1);
     Dhop(in,out,DaggerYes);
-    return axpy_norm(out,4+mass,in,out);
+    return this->EpilogueEnd(out._grid);
+  }
+
+  // Nothing outside sees the intermediate, so an Impl with packed spinor storage keeps it
+  // packed; the halo exchange of the second sweep still reads the faces of tmp in full
+  template<class Impl>
+  void WilsonFermion<Impl>::MdagM(const FermionField &in, FermionField &out,RealD &n1,RealD &n2)
+  {
+    FermionField tmp(in._grid);
+    Impl::KeepPacked(tmp,Stencil._surface_sites);
+    n1=M(in,tmp);
+    n2=Mdag(tmp,out);
+    Impl::ReleasePacked();
   }
 
   template<class Impl>
@@ -79,6 +136,27 @@ namespace QCD {
     }
   }
 
+  // Mooee is the scalar 4+m, so both Schur products are a single hopping sweep;
+  // neither needs the scratch field nor overwrites x
+  template<class Impl>
+  void WilsonFermion<Impl>::MooeeInvMeooe(const FermionField &in, FermionField &out,FermionField &scratch,int dag) 
+  {
+    this->EpilogueBegin(1.0/(4.0+mass),0.0,NULL,0);
+    if ( dag ) MeooeDag(in,out);
+    else       Meooe(in,out);
+    this->EpilogueEnd(out._grid);
+  }
+
+  template<class Impl>
+  RealD WilsonFermion<Impl>::MooeeMinusMeooe(const FermionField &in,FermionField &x, FermionField &out,int dag) 
+  {
+    assert(in.checkerboard!=x.checkerboard);
+    this->EpilogueBegin(-1.0,4.0+mass,&in,1);
+    if ( dag ) MeooeDag(x,out);
+    else       Meooe(x,out);
+    return this->EpilogueEnd(out._grid);
+  }
+
   template<class Impl>
   void WilsonFermion<Impl>::Mooee(const FermionField &in, FermionField &out) {
     out.checkerboard = in.checkerboard;
@@ -242,7 +320,7 @@ PARALLEL_FOR_LOOP
   template<class Impl>
   void WilsonFermion<Impl>::DhopDirDisp(const FermionField &in, FermionField &out,int dirdisp,int gamma,int dag) {
     
-    Compressor compressor(dag);
+    Compressor compressor(dag,this->Params.halfprecision_comms);
     
     Stencil.HaloExchange(in,comm_buf,compressor);
     
@@ -260,37 +338,99 @@ PARALLEL_FOR_LOOP
 
     assert((dag==DaggerNo) ||(dag==DaggerYes));
 
-    Compressor compressor(dag);
-    st.HaloExchange(in,comm_buf,compressor);
-    
-    if ( dag == DaggerYes ) {
-      if( HandOptDslash ) {
-PARALLEL_FOR_LOOP
-        for(int sss=0;sss<in._grid->oSites();sss++){
-	  Kernels::DiracOptHandDhopSiteDag(st,U,comm_buf,sss,sss,in,out);
-	}
-      } else { 
-PARALLEL_FOR_LOOP
-        for(int sss=0;sss<in._grid->oSites();sss++){
-	  Kernels::DiracOptDhopSiteDag(st,U,comm_buf,sss,sss,in,out);
-	}
-      }
-    } else {
-      if( HandOptDslash ) {
-PARALLEL_FOR_LOOP
-        for(int sss=0;sss<in._grid->oSites();sss++){
-	  Kernels::DiracOptHandDhopSite(st,U,comm_buf,sss,sss,in,out);
-	}
-      } else { 
-PARALLEL_FOR_LOOP
-        for(int sss=0;sss<in._grid->oSites();sss++){
-	  Kernels::DiracOptDhopSite(st,U,comm_buf,sss,sss,in,out);
+    Compressor compressor(dag,this->Params.halfprecision_comms);
+
+#ifdef GRID_OMP
+    int ncomms = GridThread::GetCommsThreads();
+    if ( ncomms && (ncomms < GridThread::GetThreads()) && !omp_in_parallel() ) {
+      GridThreadBarrier comms_barrier(ncomms);
+      st.HaloExchangePrepare(in,comm_buf,compressor);
+#pragma omp parallel
+      {
+	int me   = omp_get_thread_num();
+	int nthr = omp_get_num_threads();
+	int mywork, myoff;
+	assert(nthr > ncomms);
+	if ( me < ncomms ) {
+	  st.HaloGather(in,compressor,me,ncomms);
+	  comms_barrier.Wait();
+	  if ( me == 0 ) {
+	    st.HaloExchangeStart();
+	    st.HaloExchangeWait();
+	  }
+	  comms_barrier.Wait();
+	  st.HaloMerge(me,ncomms);
+	} else {
+	  GridThread::GetWork(st._interior_sites.size(),me-ncomms,mywork,myoff,nthr-ncomms);
+	  DhopSiteRange(st,U,in,out,dag,st._interior_sites,myoff,myoff+mywork);
 	}
+#pragma omp barrier
+	GridThread::GetWork(st._surface_sites.size(),me,mywork,myoff,nthr);
+	DhopSiteRange(st,U,in,out,dag,st._surface_sites,myoff,myoff+mywork);
       }
+      st.HaloExchangeFinish();
+      return;
+    }
+#endif
+
+    // Sites with every neighbour on node are computed while the faces are in flight
+    st.HaloExchangeBegin(in,comm_buf,compressor);
+    DhopSites(st,U,in,out,dag,st._interior_sites);
+    st.HaloExchangeComplete();
+    DhopSites(st,U,in,out,dag,st._surface_sites);
+  };
+
+  template<class Impl>
+  void WilsonFermion<Impl>::DhopSites(StencilImpl & st,DoubledGaugeField & U,
+				      const FermionField &in, FermionField &out,int dag,
+				      std::vector<int> &sites) {
+    int threads = GridThread::GetThreads();
+    int cores   = GridThread::GetCores();
+    int HT      = GridThread::GetHyperThreads();
+    int nwork   = sites.size();
+
+    // Without --cores every thread is its own core
+    if ( cores == 1 ) {
+      cores = threads;
+      HT    = 1;
+    }
+
+    // Each core sweeps a contiguous run of the site table, which is in LebesgueOrder when
+    // enabled, and its hyperthreads interleave within the run so that they share links
+    // and neighbouring spinors in cache. As for the 5d operator, but without an s-loop.
+#pragma omp parallel for schedule(static)
+    for(int t=0;t<threads;t++){
+      int hyperthread = t%HT;
+      int core        = t/HT;
+      int sswork, ssoff;
+      GridThread::GetWork(nwork,core,sswork,ssoff,cores);
+      DhopSiteRange(st,U,in,out,dag,sites,ssoff+hyperthread,ssoff+sswork,HT);
     }
   };
  
+  template<class Impl>
+  void WilsonFermion<Impl>::DhopSiteRange(StencilImpl & st,DoubledGaugeField & U,
+					  const FermionField &in, FermionField &out,int dag,
+					  std::vector<int> &sites,int begin,int end,int stride) {
+    int hand = ( DslashKernel() == DslashTuner::Hand );
+    for(int ss=begin;ss<end;ss+=stride){
+      if ( ss+stride < end ) {
+	Kernels::DhopSitePrefetch(st,U,sites[ss+stride],sites[ss+stride],in);
+      }
+      int sss = sites[ss];
+      if ( dag == DaggerYes ) {
+	if( hand ) Kernels::DiracOptHandDhopSiteDag(st,U,comm_buf,sss,sss,in,out);
+	else       Kernels::DiracOptDhopSiteDag    (st,U,comm_buf,sss,sss,in,out);
+      } else {
+	if( hand ) Kernels::DiracOptHandDhopSite(st,U,comm_buf,sss,sss,in,out);
+	else       Kernels::DiracOptDhopSite    (st,U,comm_buf,sss,sss,in,out);
+      }
+    }
+  };
+
   FermOpTemplateInstantiate(WilsonFermion);
+  FermOp4dTwoRowTemplateInstantiate(WilsonFermion);
+  FermOp4dHalfTemplateInstantiate(WilsonFermion);
 
 
 }}
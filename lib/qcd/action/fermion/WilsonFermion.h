@@ -35,6 +35,7 @@ namespace Grid {
       //////////////////////////////////////////////////////////////////
       RealD M(const FermionField &in, FermionField &out);
       RealD Mdag(const FermionField &in, FermionField &out);
+      void  MdagM(const FermionField &in, FermionField &out,RealD &n1,RealD &n2);
 
       /////////////////////////////////////////////////////////
       // half checkerboard operations
@@ -49,6 +50,10 @@ namespace Grid {
       virtual void MooeeInv(const FermionField &in, FermionField &out) ;
       virtual void MooeeInvDag(const FermionField &in, FermionField &out) ;
 
+      // Fused Schur products; twisted mass and clover fall back to the composed forms
+      virtual void  MooeeInvMeooe(const FermionField &in, FermionField &out,FermionField &scratch,int dag) ;
+      virtual RealD MooeeMinusMeooe(const FermionField &in,FermionField &x, FermionField &out,int dag) ;
+
       ////////////////////////
       // Derivative interface
       ////////////////////////
@@ -85,6 +90,17 @@ namespace Grid {
       void DhopInternal(StencilImpl & st,DoubledGaugeField & U,
 			const FermionField &in, FermionField &out,int dag) ;
 
+      // Applies the hopping term on a site table of the stencil (interior or surface)
+      void DhopSites(StencilImpl & st,DoubledGaugeField & U,
+		     const FermionField &in, FermionField &out,int dag,
+		     std::vector<int> &sites) ;
+
+      // Single thread sweep of sites[begin,end) with the given stride, prefetching one
+      // site ahead; called inside a parallel region
+      void DhopSiteRange(StencilImpl & st,DoubledGaugeField & U,
+			 const FermionField &in, FermionField &out,int dag,
+			 std::vector<int> &sites,int begin,int end,int stride=1) ;
+
 
       // Constructor
       WilsonFermion(GaugeField &_Umu,
@@ -97,6 +113,11 @@ namespace Grid {
       // DoubleStore impl dependent
       void ImportGauge(const GaugeField &_Umu);
 
+      // Kernel (DslashTuner::Generic/Hand) and site table blocking for this operator;
+      // an empty block is lexicographic. Chosen by DslashTuner under --dslash-tune.
+      void SetDslashVariant(int kernel,const std::vector<int> &block);
+      int  DslashKernel(void);
+
       ///////////////////////////////////////////////////////////////
       // Data members require to support the functionality
       ///////////////////////////////////////////////////////////////
@@ -121,6 +142,13 @@ namespace Grid {
 
       // Comms buffer
       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  comm_buf;
+
+      // Site traversal order of the stencil site tables (--lebesgue, --cacheblocking)
+      LebesgueOrder Lebesgue;
+      LebesgueOrder LebesgueEvenOdd;
+
+      // -1 follows the global --dslash-opt flag
+      int TunedKernel;
       
     };
 
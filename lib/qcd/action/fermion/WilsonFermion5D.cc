@@ -31,7 +31,8 @@ WilsonFermion5D<Impl>::WilsonFermion5D(GaugeField &_Umu,
   UmuEven(_FourDimRedBlackGrid),
   UmuOdd (_FourDimRedBlackGrid),
   Lebesgue(_FourDimGrid),
-  LebesgueEvenOdd(_FourDimRedBlackGrid)
+  LebesgueEvenOdd(_FourDimRedBlackGrid),
+  TunedKernel(-1)
 {
   // some assertions
   assert(FiveDimGrid._ndimension==5);
@@ -66,14 +67,62 @@ WilsonFermion5D<Impl>::WilsonFermion5D(GaugeField &_Umu,
     assert(FiveDimGrid._simd_layout[d+1]        ==FourDimGrid._simd_layout[d]);
   }
 
+  // Doubled links were built in the initialiser list; charge them to the action
+  AllocationPool::Attribute(&Umu._odata[0]    ,"Fermion");
+  AllocationPool::Attribute(&UmuEven._odata[0],"Fermion");
+  AllocationPool::Attribute(&UmuOdd._odata[0] ,"Fermion");
+
   // Allocate the required comms buffer
-  comm_buf.resize(Stencil._unified_buffer_size); // this is always big enough to contain EO
+  {
+    AllocationCategory category("Stencil");
+    comm_buf.resize(Stencil._unified_buffer_size); // this is always big enough to contain EO
+  }
+
+  // Site tables run over 4d sites with the s-loop innermost in the kernels
+  int lebesgue = LebesgueOrder::UseLebesgueOrder;
+  Stencil.BuildSiteTables(Ls,lebesgue ? &Lebesgue : NULL);
+  StencilEven.BuildSiteTables(Ls,lebesgue ? &LebesgueEvenOdd : NULL);
+  StencilOdd.BuildSiteTables(Ls,lebesgue ? &LebesgueEvenOdd : NULL);
 
   ImportGauge(_Umu);
   commtime=0;
   dslashtime=0;
+
+  if ( DslashTuner::Enabled ) {
+#if defined(AVX512) || defined(IMCI)
+    DslashTuner::Tune(*this,Ls,3);
+#else
+    DslashTuner::Tune(*this,Ls,2);
+#endif
+    commtime=0;
+    dslashtime=0;
+  }
 }  
 template<class Impl>
+void WilsonFermion5D<Impl>::SetDslashVariant(int kernel,const std::vector<int> &block)
+{
+  TunedKernel = kernel;
+  if ( block.size() ) {
+    Lebesgue        = LebesgueOrder(_FourDimGrid,block);
+    LebesgueEvenOdd = LebesgueOrder(_FourDimRedBlackGrid,block);
+    Stencil.BuildSiteTables(Ls,&Lebesgue);
+    StencilEven.BuildSiteTables(Ls,&LebesgueEvenOdd);
+    StencilOdd.BuildSiteTables(Ls,&LebesgueEvenOdd);
+  } else {
+    Stencil.BuildSiteTables(Ls);
+    StencilEven.BuildSiteTables(Ls);
+    StencilOdd.BuildSiteTables(Ls);
+  }
+}
+template<class Impl>
+int WilsonFermion5D<Impl>::DslashKernel(void)
+{
+  if ( TunedKernel >= 0 )   return TunedKernel;
+  if ( this->AsmOptDslash ) return DslashTuner::Asm;
+  if ( this->HandOptDslash) return DslashTuner::Hand;
+  return DslashTuner::Generic;
+}
+template<class Impl>
 void WilsonFermion5D<Impl>::ImportGauge(const GaugeField &_Umu)
 {
   Impl::DoubleStore(GaugeGrid(),Umu,_Umu);
@@ -88,7 +137,7 @@ void WilsonFermion5D<Impl>::DhopDir(const FermionField &in, FermionField &out,in
   //  assert( (disp==1)||(disp==-1) );
   //  assert( (dir>=0)&&(dir<4) ); //must do x,y,z or t;
 
-  Compressor compressor(DaggerNo);
+  Compressor compressor(DaggerNo,this->Params.halfprecision_comms);
   Stencil.HaloExchange(in,comm_buf,compressor);
   
   int skip = (disp==1) ? 0 : 1;
@@ -238,133 +287,151 @@ void WilsonFermion5D<Impl>::DhopDerivOE(GaugeField &mat,
 }
 
 template<class Impl>
-void WilsonFermion5D<Impl>::DhopInternal(StencilImpl & st, LebesgueOrder &lo,
+void WilsonFermion5D<Impl>::DhopInternal(StencilImpl & st,
 					 DoubledGaugeField & U,
 					 const FermionField &in, FermionField &out,int dag)
 {
   //  assert((dag==DaggerNo) ||(dag==DaggerYes));
 
-  Compressor compressor(dag);
+  Compressor compressor(dag,this->Params.halfprecision_comms);
+
+#ifdef GRID_OMP
+  int ncomms = GridThread::GetCommsThreads();
+  if ( ncomms && (ncomms < GridThread::GetThreads()) && !omp_in_parallel() ) {
+    GridThreadBarrier comms_barrier(ncomms);
+    commtime -=usecond();
+    st.HaloExchangePrepare(in,comm_buf,compressor);
+    commtime +=usecond();
+    dslashtime -=usecond();
+#pragma omp parallel
+    {
+      int me   = omp_get_thread_num();
+      int nthr = omp_get_num_threads();
+      int mywork, myoff;
+      assert(nthr > ncomms);
+      if ( me < ncomms ) {
+	st.HaloGather(in,compressor,me,ncomms);
+	comms_barrier.Wait();
+	if ( me == 0 ) {
+	  commtime -=usecond();
+	  st.HaloExchangeStart();
+	  st.HaloExchangeWait();
+	  commtime +=usecond();
+	}
+	comms_barrier.Wait();
+	st.HaloMerge(me,ncomms);
+      } else {
+	GridThread::GetWork(st._interior_sites.size(),me-ncomms,mywork,myoff,nthr-ncomms);
+	DhopSiteRange(st,U,in,out,dag,st._interior_sites,myoff,myoff+mywork);
+      }
+#pragma omp barrier
+      GridThread::GetWork(st._surface_sites.size(),me,mywork,myoff,nthr);
+      DhopSiteRange(st,U,in,out,dag,st._surface_sites,myoff,myoff+mywork);
+    }
+    dslashtime +=usecond();
+    st.HaloExchangeFinish();
+    return;
+  }
+#endif
 
+  // Interior 4d sites overlap the face exchange; the surface follows completion
+  commtime -=usecond();
+  st.HaloExchangeBegin(in,comm_buf,compressor);
+  commtime +=usecond();
+
+  dslashtime -=usecond();
+  DhopSites(st,U,in,out,dag,st._interior_sites);
+  dslashtime +=usecond();
+
+  commtime -=usecond();
+  st.HaloExchangeComplete();
+  commtime +=usecond();
+
+  dslashtime -=usecond();
+  DhopSites(st,U,in,out,dag,st._surface_sites);
+  dslashtime +=usecond();
+}
+
+template<class Impl>
+void WilsonFermion5D<Impl>::DhopSites(StencilImpl & st,
+				      DoubledGaugeField & U,
+				      const FermionField &in, FermionField &out,int dag,
+				      std::vector<int> &sites)
+{
   // Assume balanced KMP_AFFINITY; this is forced in GridThread.h
 
   int threads = GridThread::GetThreads();
   int HT      = GridThread::GetHyperThreads();
   int cores   = GridThread::GetCores();
-  int nwork = U._grid->oSites();
-  
-  commtime -=usecond();
-  st.HaloExchange(in,comm_buf,compressor);
-  commtime +=usecond();
+  int nwork = sites.size();
+  int kernel  = DslashKernel();
+
+  // Without --cores every thread is its own core
+  if ( cores == 1 ) {
+    cores = threads;
+    HT    = 1;
+  }
   
   // Dhop takes the 4d grid from U, and makes a 5d index for fermion
   // Not loop ordering and data layout.
   // Designed to create 
   // - per thread reuse in L1 cache for U
   // - 8 linear access unit stride streams per thread for Fermion for hw prefetchable.
-  dslashtime -=usecond();
-  if ( dag == DaggerYes ) {
-    if( this->HandOptDslash ) {
+  // Site tables are already in LebesgueOrder when it is enabled.
+  // Cores take contiguous runs of 4d sites and their hyperthreads split Ls, the same
+  // for every kernel and for both DaggerNo and DaggerYes.
 #pragma omp parallel for schedule(static)
-      for(int ss=0;ss<U._grid->oSites();ss++){
-	int sU=ss;
-	for(int s=0;s<Ls;s++){
-	  int sF = s+Ls*sU;
-	  Kernels::DiracOptHandDhopSiteDag(st,U,comm_buf,sF,sU,in,out);
-	  }
-      }
-    } else { 
-PARALLEL_FOR_LOOP
-      for(int ss=0;ss<U._grid->oSites();ss++){
-	{
-	  int sd;
-	  for(sd=0;sd<Ls;sd++){
-	    int sU=ss;
-	    int sF = sd+Ls*sU;
-	    Kernels::DiracOptDhopSiteDag(st,U,comm_buf,sF,sU,in,out);
-	  }
-	}
-      }
-    }
-  } else {
-    if( this->AsmOptDslash ) {
-      //      for(int i=0;i<1;i++){
-      //      for(int i=0;i< PerformanceCounter::NumTypes(); i++ ){
-      //	PerformanceCounter Counter(i);
-      //	Counter.Start();
+  for(int t=0;t<threads;t++){
 
-#pragma omp parallel for 
-      for(int t=0;t<threads;t++){
+    int hyperthread = t%HT;
+    int core        = t/HT;
 
-	int hyperthread = t%HT;
-	int core        = t/HT;
-
-        int sswork, swork,soff,ssoff,  sU,sF;
+    int sswork, swork,soff,ssoff,  sU,sF;
 	
-	GridThread::GetWork(nwork,core,sswork,ssoff,cores);
-	GridThread::GetWork(Ls   , hyperthread, swork, soff,HT);
-
-	for(int ss=0;ss<sswork;ss++){
-	  for(int s=soff;s<soff+swork;s++){
-
-	    sU=ss+ ssoff;
-
-	    if ( LebesgueOrder::UseLebesgueOrder ) {
-	      sU = lo.Reorder(sU);
-	    }
-	    sF = s+Ls*sU;
-	    Kernels::DiracOptAsmDhopSite(st,U,comm_buf,sF,sU,in,out,(uint64_t *)0);// &buf[0]
-	  }
+    GridThread::GetWork(nwork,core,sswork,ssoff,cores);
+    GridThread::GetWork(Ls   , hyperthread, swork, soff,HT);
+
+    for(int ss=0;ss<sswork;ss++){
+      sU=sites[ss+ ssoff];
+      for(int s=soff;s<soff+swork;s++){
+	sF = s+Ls*sU;
+	if ( dag == DaggerYes ) {
+	  // no assembler dagger kernel; Asm runs the hand unrolled one for DaggerYes
+	  if ( kernel == DslashTuner::Generic ) Kernels::DiracOptDhopSiteDag    (st,U,comm_buf,sF,sU,in,out);
+	  else                                  Kernels::DiracOptHandDhopSiteDag(st,U,comm_buf,sF,sU,in,out);
+	} else {
+	  if     ( kernel == DslashTuner::Asm )  Kernels::DiracOptAsmDhopSite (st,U,comm_buf,sF,sU,in,out,(uint64_t *)0);
+	  else if( kernel == DslashTuner::Hand ) Kernels::DiracOptHandDhopSite(st,U,comm_buf,sF,sU,in,out);
+	  else                                   Kernels::DiracOptDhopSite    (st,U,comm_buf,sF,sU,in,out);
 	}
       }
-      //      Counter.Stop();
-      //      Counter.Report();
-      //      }
-    } else if( this->HandOptDslash ) {
-      /*
-
-#pragma omp parallel for schedule(static)
-      for(int t=0;t<threads;t++){
-
-	int hyperthread = t%HT;
-	int core        = t/HT;
-
-        int sswork, swork,soff,ssoff,  sU,sF;
-	
-	GridThread::GetWork(nwork,core,sswork,ssoff,cores);
-	GridThread::GetWork(Ls   , hyperthread, swork, soff,HT);
-
-	for(int ss=0;ss<sswork;ss++){
-	  sU=ss+ ssoff;
-	  for(int s=soff;s<soff+swork;s++){
-	    sF = s+Ls*sU;
-	    Kernels::DiracOptHandDhopSite(st,U,comm_buf,sF,sU,in,out);
-	  }
-	}
-      }
-      */
-
-#pragma omp parallel for schedule(static)
-      for(int ss=0;ss<U._grid->oSites();ss++){
-	int sU=ss;
-	for(int s=0;s<Ls;s++){
-	  int sF = s+Ls*sU;
-	  Kernels::DiracOptHandDhopSite(st,U,comm_buf,sF,sU,in,out);
-	}
-      }
-    } else { 
-PARALLEL_FOR_LOOP
-      for(int ss=0;ss<U._grid->oSites();ss++){
-	int sU=ss;
-	for(int s=0;s<Ls;s++){
-	  int sF = s+Ls*sU; 
-	  Kernels::DiracOptDhopSite(st,U,comm_buf,sF,sU,in,out);
-	}
+    }
+  }
+}
+template<class Impl>
+void WilsonFermion5D<Impl>::DhopSiteRange(StencilImpl & st,
+					  DoubledGaugeField & U,
+					  const FermionField &in, FermionField &out,int dag,
+					  std::vector<int> &sites,int begin,int end)
+{
+  int kernel = DslashKernel();
+  for(int ss=begin;ss<end;ss++){
+    int sU=sites[ss];
+    for(int s=0;s<Ls;s++){
+      int sF = s+Ls*sU;
+      if ( dag == DaggerYes ) {
+	// no assembler dagger kernel; Asm runs the hand unrolled one for DaggerYes
+	if ( kernel == DslashTuner::Generic ) Kernels::DiracOptDhopSiteDag    (st,U,comm_buf,sF,sU,in,out);
+	else                                  Kernels::DiracOptHandDhopSiteDag(st,U,comm_buf,sF,sU,in,out);
+      } else {
+	if     ( kernel == DslashTuner::Asm )  Kernels::DiracOptAsmDhopSite (st,U,comm_buf,sF,sU,in,out,(uint64_t *)0);
+	else if( kernel == DslashTuner::Hand ) Kernels::DiracOptHandDhopSite(st,U,comm_buf,sF,sU,in,out);
+	else                                   Kernels::DiracOptDhopSite    (st,U,comm_buf,sF,sU,in,out);
       }
     }
   }
-  dslashtime +=usecond();
 }
+
 template<class Impl>
 void WilsonFermion5D<Impl>::DhopOE(const FermionField &in, FermionField &out,int dag)
 {
@@ -374,7 +441,7 @@ void WilsonFermion5D<Impl>::DhopOE(const FermionField &in, FermionField &out,int
   assert(in.checkerboard==Even);
   out.checkerboard = Odd;
 
-  DhopInternal(StencilEven,LebesgueEvenOdd,UmuOdd,in,out,dag);
+  DhopInternal(StencilEven,UmuOdd,in,out,dag);
 }
 template<class Impl>
 void WilsonFermion5D<Impl>::DhopEO(const FermionField &in, FermionField &out,int dag)
@@ -385,7 +452,7 @@ void WilsonFermion5D<Impl>::DhopEO(const FermionField &in, FermionField &out,int
   assert(in.checkerboard==Odd);
   out.checkerboard = Even;
 
-  DhopInternal(StencilOdd,LebesgueEvenOdd,UmuEven,in,out,dag);
+  DhopInternal(StencilOdd,UmuEven,in,out,dag);
 }
 template<class Impl>
 void WilsonFermion5D<Impl>::Dhop(const FermionField &in, FermionField &out,int dag)
@@ -395,7 +462,7 @@ void WilsonFermion5D<Impl>::Dhop(const FermionField &in, FermionField &out,int d
 
   out.checkerboard = in.checkerboard;
 
-  DhopInternal(Stencil,Lebesgue,Umu,in,out,dag);
+  DhopInternal(Stencil,Umu,in,out,dag);
 }
 template<class Impl>
 void WilsonFermion5D<Impl>::DW(const FermionField &in, FermionField &out,int dag)
@@ -82,12 +82,27 @@ namespace Grid {
 			 int dag);
 
       void DhopInternal(StencilImpl & st,
-			LebesgueOrder &lo,
 			DoubledGaugeField &U,
 			const FermionField &in, 
 			FermionField &out,
 			int dag);
 
+      // Hopping term on a 4d site table of the stencil (interior or surface)
+      void DhopSites(StencilImpl & st,
+		     DoubledGaugeField &U,
+		     const FermionField &in, 
+		     FermionField &out,
+		     int dag,
+		     std::vector<int> &sites);
+
+      // Single thread sweep of 4d sites[begin,end), all s; called inside a parallel region
+      void DhopSiteRange(StencilImpl & st,
+			 DoubledGaugeField &U,
+			 const FermionField &in, 
+			 FermionField &out,
+			 int dag,
+			 std::vector<int> &sites,int begin,int end);
+
       // Constructors
       WilsonFermion5D(GaugeField &_Umu,
 		      GridCartesian         &FiveDimGrid,
@@ -99,6 +114,11 @@ namespace Grid {
       // DoubleStore
       void ImportGauge(const GaugeField &_Umu);
 
+      // Kernel (DslashTuner::Generic/Hand/Asm) and site table blocking for this operator;
+      // an empty block is lexicographic. Chosen by DslashTuner under --dslash-tune.
+      void SetDslashVariant(int kernel,const std::vector<int> &block);
+      int  DslashKernel(void);
+
       void Report(void);
       ///////////////////////////////////////////////////////////////
       // Data members require to support the functionality
@@ -127,6 +147,9 @@ namespace Grid {
       LebesgueOrder Lebesgue;
       LebesgueOrder LebesgueEvenOdd;
 
+      // -1 follows the global --dslash-opt / AsmOptDslash flags
+      int TunedKernel;
+
       // Comms buffer
       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  comm_buf;
       
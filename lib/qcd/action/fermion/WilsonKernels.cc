@@ -3,7 +3,47 @@ namespace Grid {
 namespace QCD {
 
 template<class Impl> 
-WilsonKernels<Impl>::WilsonKernels(const ImplParams &p): Base(p) {};
+WilsonKernels<Impl>::WilsonKernels(const ImplParams &p): Base(p), _epi_on(0), _epi_norm(0), _epi_x(NULL) {
+  _epi_stride = (64+sizeof(Simd)-1)/sizeof(Simd);
+};
+
+template<class Impl> 
+void WilsonKernels<Impl>::EpilogueBegin(RealD a,RealD b,const FermionField *x,int norm)
+{
+  assert(!_epi_on); // one sweep at a time per operator
+  _epi_on   = 1;
+  _epi_a    = a;
+  _epi_b    = b;
+  _epi_x    = x;
+  _epi_norm = norm;
+  if ( norm ) { 
+    int nthr = GridThread::GetThreads();
+#ifdef GRID_OMP
+    nthr = std::max(nthr,omp_get_max_threads());
+#endif
+    _epi_sum.resize(nthr*_epi_stride);
+    for(int t=0;t<_epi_sum.size();t++) _epi_sum[t]=zero;
+  }
+}
+
+template<class Impl> 
+RealD WilsonKernels<Impl>::EpilogueEnd(GridBase *grid)
+{
+  assert(_epi_on);
+  RealD nrm=0.0;
+  if ( _epi_norm ) { 
+    Simd vnrm; vnrm=zero;  // sum across threads in a fixed order
+    for(int t=0;t<_epi_sum.size();t+=_epi_stride){
+      vnrm = vnrm+_epi_sum[t];
+    }
+    nrm = real(Reduce(vnrm));
+    grid->GlobalSum(nrm);
+  }
+  _epi_on   = 0;
+  _epi_norm = 0;
+  _epi_x    = NULL;
+  return nrm;
+}
 
 template<class Impl> 
 void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField &U,
@@ -14,16 +54,17 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   SiteHalfSpinor  chi;    
   SiteHalfSpinor Uchi;
   SiteSpinor result;
+  SiteSpinor nbr;
   StencilEntry *SE;
   int ptype;
 
   // Xp
   SE=st.GetEntry(ptype,Xp,sF);
   if ( SE->_is_local && SE->_permute ) {
-    spProjXp(tmp,in._odata[SE->_offset]);
+    spProjXp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjXp(chi,in._odata[SE->_offset]);
+    spProjXp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -33,10 +74,10 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   // Yp
   SE=st.GetEntry(ptype,Yp,sF);
   if ( SE->_is_local && SE->_permute ) {
-    spProjYp(tmp,in._odata[SE->_offset]);
+    spProjYp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjYp(chi,in._odata[SE->_offset]);
+    spProjYp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -46,10 +87,10 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   // Zp
   SE=st.GetEntry(ptype,Zp,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjZp(tmp,in._odata[SE->_offset]);
+    spProjZp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjZp(chi,in._odata[SE->_offset]);
+    spProjZp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -59,10 +100,10 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   // Tp
   SE=st.GetEntry(ptype,Tp,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjTp(tmp,in._odata[SE->_offset]);
+    spProjTp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjTp(chi,in._odata[SE->_offset]);
+    spProjTp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -72,10 +113,10 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   // Xm
   SE=st.GetEntry(ptype,Xm,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjXm(tmp,in._odata[SE->_offset]);
+    spProjXm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjXm(chi,in._odata[SE->_offset]);
+    spProjXm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -85,10 +126,10 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   // Ym
   SE=st.GetEntry(ptype,Ym,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjYm(tmp,in._odata[SE->_offset]);
+    spProjYm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjYm(chi,in._odata[SE->_offset]);
+    spProjYm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -98,10 +139,10 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   // Zm
   SE=st.GetEntry(ptype,Zm,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjZm(tmp,in._odata[SE->_offset]);
+    spProjZm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjZm(chi,in._odata[SE->_offset]);
+    spProjZm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -111,17 +152,17 @@ void WilsonKernels<Impl>::DiracOptDhopSiteDag(StencilImpl &st,DoubledGaugeField
   // Tm
   SE=st.GetEntry(ptype,Tm,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjTm(tmp,in._odata[SE->_offset]);
+    spProjTm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjTm(chi,in._odata[SE->_offset]);
+    spProjTm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
   Impl::multLink(Uchi,U._odata[sU],chi,Tm,SE,st);
   accumReconTm(result,Uchi);
 
-  vstream(out._odata[sF],result*(-0.5));
+  DhopSiteStore(out,sF,result);
 };
 
 template<class Impl> 
@@ -132,6 +173,7 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   SiteHalfSpinor  tmp;    
   SiteHalfSpinor  chi;    
   SiteSpinor result;
+  SiteSpinor nbr;
   SiteHalfSpinor Uchi;
   StencilEntry *SE;
   int ptype;
@@ -139,10 +181,10 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Xp
   SE=st.GetEntry(ptype,Xm,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjXp(tmp,in._odata[SE->_offset]);
+    spProjXp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjXp(chi,in._odata[SE->_offset]);
+    spProjXp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -152,10 +194,10 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Yp
   SE=st.GetEntry(ptype,Ym,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjYp(tmp,in._odata[SE->_offset]);
+    spProjYp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjYp(chi,in._odata[SE->_offset]);
+    spProjYp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -165,10 +207,10 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Zp
   SE=st.GetEntry(ptype,Zm,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjZp(tmp,in._odata[SE->_offset]);
+    spProjZp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjZp(chi,in._odata[SE->_offset]);
+    spProjZp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -178,10 +220,10 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Tp
   SE=st.GetEntry(ptype,Tm,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjTp(tmp,in._odata[SE->_offset]);
+    spProjTp(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjTp(chi,in._odata[SE->_offset]);
+    spProjTp(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -191,10 +233,10 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Xm
   SE=st.GetEntry(ptype,Xp,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjXm(tmp,in._odata[SE->_offset]);
+    spProjXm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjXm(chi,in._odata[SE->_offset]);
+    spProjXm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -204,10 +246,10 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Ym
   SE=st.GetEntry(ptype,Yp,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjYm(tmp,in._odata[SE->_offset]);
+    spProjYm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjYm(chi,in._odata[SE->_offset]);
+    spProjYm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -217,10 +259,10 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Zm
   SE=st.GetEntry(ptype,Zp,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjZm(tmp,in._odata[SE->_offset]);
+    spProjZm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjZm(chi,in._odata[SE->_offset]);
+    spProjZm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
@@ -230,17 +272,17 @@ void WilsonKernels<Impl>::DiracOptDhopSite(StencilImpl &st,DoubledGaugeField &U,
   // Tm
   SE=st.GetEntry(ptype,Tp,sF);
   if (  SE->_is_local && SE->_permute ) {
-    spProjTm(tmp,in._odata[SE->_offset]);
+    spProjTm(tmp,Impl::loadSpinor(in,SE->_offset,nbr));
     permute(chi,tmp,ptype);
   } else if ( SE->_is_local ) {
-    spProjTm(chi,in._odata[SE->_offset]);
+    spProjTm(chi,Impl::loadSpinor(in,SE->_offset,nbr));
   } else { 
     chi=buf[SE->_offset];
   }
   Impl::multLink(Uchi,U._odata[sU],chi,Tp,SE,st);
   accumReconTm(result,Uchi);
   
-  vstream(out._odata[sF],result*(-0.5));
+  DhopSiteStore(out,sF,result);
 }
 
 template<class Impl> 
@@ -383,5 +425,7 @@ void WilsonKernels<Impl>::DiracOptAsmDhopSite(StencilImpl &st,DoubledGaugeField
 #endif
 
   FermOpTemplateInstantiate(WilsonKernels);
+  FermOp4dTwoRowTemplateInstantiate(WilsonKernels);
+  FermOp4dHalfTemplateInstantiate(WilsonKernels);
 
 }}
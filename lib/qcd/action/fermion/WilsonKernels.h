@@ -42,6 +42,63 @@ namespace Grid {
 				  int sF,int sU,const FermionField &in, FermionField &out);
 
      WilsonKernels(const ImplParams &p= ImplParams());
+
+     ////////////////////////////////////////////////////////////////////////////////////////
+     // Fused epilogue of the DhopSite kernels. Between EpilogueBegin and EpilogueEnd every
+     // site is stored as out = a*(-1/2 Dhop in) + b*x, and |out|^2 is summed per thread
+     // when asked; M and the Schur products fold their diagonal term and norm into the
+     // hopping sweep this way. Begin/End must be called outside parallel regions; the
+     // state belongs to the operator, so sweeps on one operator must not nest or overlap.
+     ////////////////////////////////////////////////////////////////////////////////////////
+     void  EpilogueBegin(RealD a,RealD b,const FermionField *x,int norm);
+     RealD EpilogueEnd(GridBase *grid);
+
+     inline void DhopSiteStore(FermionField &out,int sF,const SiteSpinor &result) {
+       if ( !_epi_on ) { 
+	 Impl::storeSpinor(out,sF,result*(-0.5));
+	 return;
+       }
+       SiteSpinor r = result*(-0.5*_epi_a);
+       if ( _epi_x ) {
+	 SiteSpinor xtmp;
+	 r = r + Impl::loadSpinor(*_epi_x,sF,xtmp)*_epi_b;
+       }
+       Impl::storeSpinor(out,sF,r);
+       if ( _epi_norm ) {
+#ifdef GRID_OMP
+	 int me = omp_get_thread_num();
+#else
+	 int me = 0;
+#endif
+	 _epi_sum[me*_epi_stride] = _epi_sum[me*_epi_stride] + TensorRemove(innerProduct(r,r));
+       }
+     }
+
+     // Request the links and on node neighbours of a site ahead of its kernel
+     inline void DhopSitePrefetch(StencilImpl &st,DoubledGaugeField &U,int sF,int sU,const FermionField &in) {
+       PrefetchLines(&U._odata[sU],sizeof(U._odata[sU]));
+       for(int point=0;point<st._npoints;point++){
+	 int ptype;
+	 StencilEntry *SE = st.GetEntry(ptype,point,sF);
+	 if ( SE->_is_local ) { 
+	   int bytes;
+	   const void *lines = Impl::spinorLines(in,SE->_offset,bytes);
+	   PrefetchLines(lines,bytes);
+	 }
+       }
+     }
+     static inline void PrefetchLines(const void *ptr,int bytes) {
+       const char *p = (const char *)ptr;
+       for(int b=0;b<bytes;b+=64) __builtin_prefetch(p+b);
+     }
+
+     int    _epi_on;
+     int    _epi_norm;
+     RealD  _epi_a;
+     RealD  _epi_b;
+     const FermionField *_epi_x;
+     int    _epi_stride; // per thread partial sums sit on separate cache lines
+     std::vector<Simd,alignedAllocator<Simd> > _epi_sum;
      
     };
 
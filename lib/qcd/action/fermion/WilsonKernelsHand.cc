@@ -277,6 +277,38 @@
   result_31-= UChi_11;	\
   result_32-= UChi_12;
 
+#define HAND_RESULT(ss)\
+  if ( this->_epi_on ) {\
+    SiteSpinor result;\
+    result()(0)(0)=result_00;\
+    result()(0)(1)=result_01;\
+    result()(0)(2)=result_02;\
+    result()(1)(0)=result_10;\
+    result()(1)(1)=result_11;\
+    result()(1)(2)=result_12;\
+    result()(2)(0)=result_20;\
+    result()(2)(1)=result_21;\
+    result()(2)(2)=result_22;\
+    result()(3)(0)=result_30;\
+    result()(3)(1)=result_31;\
+    result()(3)(2)=result_32;\
+    this->DhopSiteStore(out,ss,result);\
+  } else {\
+    SiteSpinor & ref (out._odata[ss]);\
+    vstream(ref()(0)(0),result_00*(-0.5));\
+    vstream(ref()(0)(1),result_01*(-0.5));\
+    vstream(ref()(0)(2),result_02*(-0.5));\
+    vstream(ref()(1)(0),result_10*(-0.5));\
+    vstream(ref()(1)(1),result_11*(-0.5));\
+    vstream(ref()(1)(2),result_12*(-0.5));\
+    vstream(ref()(2)(0),result_20*(-0.5));\
+    vstream(ref()(2)(1),result_21*(-0.5));\
+    vstream(ref()(2)(2),result_22*(-0.5));\
+    vstream(ref()(3)(0),result_30*(-0.5));\
+    vstream(ref()(3)(1),result_31*(-0.5));\
+    vstream(ref()(3)(2),result_32*(-0.5));\
+  }
+
 namespace Grid {
 namespace QCD {
 
@@ -508,21 +540,7 @@ void WilsonKernels<Impl >::DiracOptHandDhopSiteDag(StencilImpl &st,DoubledGaugeF
   }
   TM_RECON_ACCUM;
 
-  {
-    SiteSpinor & ref (out._odata[ss]);
-    vstream(ref()(0)(0),result_00*(-0.5));
-    vstream(ref()(0)(1),result_01*(-0.5));
-    vstream(ref()(0)(2),result_02*(-0.5));
-    vstream(ref()(1)(0),result_10*(-0.5));
-    vstream(ref()(1)(1),result_11*(-0.5));
-    vstream(ref()(1)(2),result_12*(-0.5));
-    vstream(ref()(2)(0),result_20*(-0.5));
-    vstream(ref()(2)(1),result_21*(-0.5));
-    vstream(ref()(2)(2),result_22*(-0.5));
-    vstream(ref()(3)(0),result_30*(-0.5));
-    vstream(ref()(3)(1),result_31*(-0.5));
-    vstream(ref()(3)(2),result_32*(-0.5));
-  }
+  HAND_RESULT(ss);
 }
 
 template<class Impl>
@@ -751,21 +769,7 @@ void WilsonKernels<Impl >::DiracOptHandDhopSite(StencilImpl &st,DoubledGaugeFiel
   }
   TP_RECON_ACCUM;
 
-  {
-    SiteSpinor & ref (out._odata[ss]);
-    vstream(ref()(0)(0),result_00*(-0.5));
-    vstream(ref()(0)(1),result_01*(-0.5));
-    vstream(ref()(0)(2),result_02*(-0.5));
-    vstream(ref()(1)(0),result_10*(-0.5));
-    vstream(ref()(1)(1),result_11*(-0.5));
-    vstream(ref()(1)(2),result_12*(-0.5));
-    vstream(ref()(2)(0),result_20*(-0.5));
-    vstream(ref()(2)(1),result_21*(-0.5));
-    vstream(ref()(2)(2),result_22*(-0.5));
-    vstream(ref()(3)(0),result_30*(-0.5));
-    vstream(ref()(3)(1),result_31*(-0.5));
-    vstream(ref()(3)(2),result_32*(-0.5));
-  }
+  HAND_RESULT(ss);
 }
 
   ////////////////////////////////////////////////
@@ -803,6 +807,59 @@ void WilsonKernels<GparityWilsonImplD>::DiracOptHandDhopSiteDag(StencilImpl &st,
   DiracOptDhopSiteDag(st,U,buf,sF,sU,in,out); // will template override for Wilson Nc=3
 }
 
+  ////////////////////////////////////////////////
+  // Two row links also take the simple path
+  ////////////////////////////////////////////////
+template<>
+void WilsonKernels<WilsonTwoRowImplF>::DiracOptHandDhopSite(StencilImpl &st,DoubledGaugeField &U,
+					       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  &buf,
+					       int sF,int sU,const FermionField &in, FermionField &out)
+{
+  DiracOptDhopSite(st,U,buf,sF,sU,in,out);
+}
+
+template<>
+void WilsonKernels<WilsonTwoRowImplF>::DiracOptHandDhopSiteDag(StencilImpl &st,DoubledGaugeField &U,
+					       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  &buf,
+					       int sF,int sU,const FermionField &in, FermionField &out)
+{
+  DiracOptDhopSiteDag(st,U,buf,sF,sU,in,out);
+}
+
+template<>
+void WilsonKernels<WilsonTwoRowImplD>::DiracOptHandDhopSite(StencilImpl &st,DoubledGaugeField &U,
+					       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  &buf,
+					       int sF,int sU,const FermionField &in, FermionField &out)
+{
+  DiracOptDhopSite(st,U,buf,sF,sU,in,out);
+}
+
+template<>
+void WilsonKernels<WilsonTwoRowImplD>::DiracOptHandDhopSiteDag(StencilImpl &st,DoubledGaugeField &U,
+					       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  &buf,
+					       int sF,int sU,const FermionField &in, FermionField &out)
+{
+  DiracOptDhopSiteDag(st,U,buf,sF,sU,in,out);
+}
+
+  ////////////////////////////////////////////////
+  // and so do binary16 links
+  ////////////////////////////////////////////////
+template<>
+void WilsonKernels<WilsonHalfImplF>::DiracOptHandDhopSite(StencilImpl &st,DoubledGaugeField &U,
+					       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  &buf,
+					       int sF,int sU,const FermionField &in, FermionField &out)
+{
+  DiracOptDhopSite(st,U,buf,sF,sU,in,out);
+}
+
+template<>
+void WilsonKernels<WilsonHalfImplF>::DiracOptHandDhopSiteDag(StencilImpl &st,DoubledGaugeField &U,
+					       std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> >  &buf,
+					       int sF,int sU,const FermionField &in, FermionField &out)
+{
+  DiracOptDhopSiteDag(st,U,buf,sF,sU,in,out);
+}
 
 
 template void WilsonKernels<WilsonImplF>::DiracOptHandDhopSite(StencilImpl &st,DoubledGaugeField &U,
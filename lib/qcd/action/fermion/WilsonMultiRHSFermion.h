@@ -0,0 +1,122 @@
+#ifndef  GRID_QCD_WILSON_MULTI_RHS_FERMION_H
+#define  GRID_QCD_WILSON_MULTI_RHS_FERMION_H
+
+#include <Grid.h>
+
+namespace Grid {
+
+  namespace QCD {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // 4d Wilson operator applied to a block of N independent sources at once.
+    //
+    // The block is a 5d field with Ls=N, the s index labelling the source; there is
+    // no hopping in s. The 5d kernels load each SiteDoubledGaugeField once per 4d site
+    // and apply it to all N sources, so the link traffic is amortised N-fold, and
+    // every solver, Schur and CG path of the 4d operator runs unchanged on the block.
+    // M = Dhop + (4+mass) is the 5d DW term with M5=-mass.
+    ////////////////////////////////////////////////////////////////////////////////
+    template<class Impl>
+    class WilsonMultiRHSFermion : public WilsonFermion5D<Impl>
+    {
+    public:
+     INHERIT_IMPL_TYPES(Impl);
+    public:
+
+      virtual void   Instantiatable(void) {};
+
+      // FiveDimGrid is made with makeFiveDimGrid(nrhs,FourDimGrid)
+      WilsonMultiRHSFermion(GaugeField &_Umu,
+			    GridCartesian         &FiveDimGrid,
+			    GridRedBlackCartesian &FiveDimRedBlackGrid,
+			    GridCartesian         &FourDimGrid,
+			    GridRedBlackCartesian &FourDimRedBlackGrid,
+			    RealD _mass,const ImplParams &p= ImplParams()) :
+	WilsonFermion5D<Impl>(_Umu,
+			      FiveDimGrid,
+			      FiveDimRedBlackGrid,
+			      FourDimGrid,
+			      FourDimRedBlackGrid,-_mass,p),
+	mass(_mass)
+      {
+      }
+
+      int Nrhs(void) { return this->Ls; };
+
+      virtual RealD M    (const FermionField &in, FermionField &out) {
+	this->DW(in,out,DaggerNo);
+	return norm2(out);
+      }
+      virtual RealD Mdag (const FermionField &in, FermionField &out) {
+	this->DW(in,out,DaggerYes);
+	return norm2(out);
+      }
+
+      virtual void Meooe       (const FermionField &in, FermionField &out) {
+	if ( in.checkerboard == Odd ) this->DhopEO(in,out,DaggerNo);
+	else                          this->DhopOE(in,out,DaggerNo);
+      }
+      virtual void MeooeDag    (const FermionField &in, FermionField &out) {
+	if ( in.checkerboard == Odd ) this->DhopEO(in,out,DaggerYes);
+	else                          this->DhopOE(in,out,DaggerYes);
+      }
+      virtual void Mooee       (const FermionField &in, FermionField &out) {
+	out.checkerboard = in.checkerboard;
+	out = (4.0+mass)*in;
+      }
+      virtual void MooeeDag    (const FermionField &in, FermionField &out) {
+	Mooee(in,out);
+      }
+      virtual void MooeeInv    (const FermionField &in, FermionField &out) {
+	out.checkerboard = in.checkerboard;
+	out = (1.0/(4.0+mass))*in;
+      }
+      virtual void MooeeInvDag (const FermionField &in, FermionField &out) {
+	MooeeInv(in,out);
+      }
+
+      // dir is a 4d direction as for WilsonFermion; the 5d DhopDir counts s as direction 0
+      virtual void Mdir (const FermionField &in, FermionField &out,int dir,int disp) {
+	this->DhopDir(in,out,dir+1,disp);
+      }
+
+      ////////////////////////////////////////////////////////////////////////////
+      // Block <-> sources. Sources live on the 4d (red black) grid and the block on
+      // the matching 5d grid; site s+Ls*ss of the block is site ss of source s.
+      ////////////////////////////////////////////////////////////////////////////
+      void ImportSources(const std::vector<FermionField> &src,FermionField &block) {
+	int Ls = this->Ls;
+	assert(src.size()==Ls);
+	int nsite = src[0]._grid->oSites();
+	assert(block._grid->oSites()==nsite*Ls);
+	for(int s=0;s<Ls;s++) conformable(src[s],src[0]);
+	block.checkerboard = src[0].checkerboard;
+PARALLEL_FOR_LOOP
+	for(int ss=0;ss<nsite;ss++){
+	  for(int s=0;s<Ls;s++){
+	    block._odata[s+Ls*ss] = src[s]._odata[ss];
+	  }
+	}
+      }
+
+      void ExportSources(const FermionField &block,std::vector<FermionField> &src) {
+	int Ls = this->Ls;
+	assert(src.size()==Ls);
+	int nsite = src[0]._grid->oSites();
+	assert(block._grid->oSites()==nsite*Ls);
+	for(int s=0;s<Ls;s++) src[s].checkerboard = block.checkerboard;
+PARALLEL_FOR_LOOP
+	for(int ss=0;ss<nsite;ss++){
+	  for(int s=0;s<Ls;s++){
+	    src[s]._odata[ss] = block._odata[s+Ls*ss];
+	  }
+	}
+      }
+
+      RealD mass;
+    };
+
+  }
+}
+
+#endif
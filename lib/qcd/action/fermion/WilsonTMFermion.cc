@@ -66,6 +66,8 @@ namespace QCD {
   }
 
   FermOpTemplateInstantiate(WilsonTMFermion);
+  FermOp4dTwoRowTemplateInstantiate(WilsonTMFermion);
+  FermOp4dHalfTemplateInstantiate(WilsonTMFermion);
 
 }
 }
@@ -39,6 +39,14 @@ namespace Grid {
     virtual void MooeeInv(const FermionField &in, FermionField &out) ;
     virtual void MooeeInvDag(const FermionField &in, FermionField &out) ;
 
+    // The twisted diagonal does not fold into the Wilson epilogue; use the composed products
+    virtual void  MooeeInvMeooe(const FermionField &in, FermionField &out,FermionField &scratch,int dag) {
+      CheckerBoardedSparseMatrixBase<FermionField>::MooeeInvMeooe(in,out,scratch,dag);
+    }
+    virtual RealD MooeeMinusMeooe(const FermionField &in,FermionField &x, FermionField &out,int dag) {
+      return CheckerBoardedSparseMatrixBase<FermionField>::MooeeMinusMeooe(in,x,out,dag);
+    }
+
   private:
      RealD mu; // TwistedMass parameter
 
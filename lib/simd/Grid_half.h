@@ -0,0 +1,148 @@
+#ifndef GRID_HALF_H
+#define GRID_HALF_H
+
+#include <cstring>
+#include <cmath>
+#ifdef __F16C__
+#include <immintrin.h>
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+// IEEE 754 binary16 storage format. There is no arithmetic on RealH; values are
+// converted to single precision for compute, and are used to cut the bytes moved by
+// comms and by memory bound kernels.
+//////////////////////////////////////////////////////////////////////////////////////////
+namespace Grid {
+
+  typedef uint16_t RealH;
+
+  // Round to nearest even; overflow saturates to inf, subnormals are preserved.
+  inline RealH FloatToHalf(RealF f)
+  {
+    uint32_t x;
+    std::memcpy(&x,&f,sizeof(x));
+    uint32_t sign = (x>>16)&0x8000;
+    int32_t  exp  = ((x>>23)&0xff) - 127 + 15;
+    uint32_t mant = x&0x7fffff;
+
+    if ( ((x>>23)&0xff) == 0xff ) { // inf or nan
+      return sign | 0x7c00 | (mant ? 0x200 : 0);
+    }
+    if ( exp >= 0x1f ) return sign | 0x7c00;
+    if ( exp <= 0 ) {
+      if ( exp < -10 ) return sign;
+      mant |= 0x800000;
+      int shift = 14-exp;
+      uint32_t h    = mant>>shift;
+      uint32_t rem  = mant&((1u<<shift)-1);
+      uint32_t half = 1u<<(shift-1);
+      if ( (rem>half) || ((rem==half)&&(h&1)) ) h++;
+      return sign | h;
+    }
+    uint32_t h   = sign | (exp<<10) | (mant>>13);
+    uint32_t rem = mant&0x1fff;
+    if ( (rem>0x1000) || ((rem==0x1000)&&(h&1)) ) h++; // carry into exponent is correct rounding
+    return h;
+  }
+
+  inline RealF HalfToFloat(RealH h)
+  {
+    uint32_t sign = (h&0x8000)<<16;
+    uint32_t exp  = (h>>10)&0x1f;
+    uint32_t mant = h&0x3ff;
+    uint32_t x;
+    if ( exp == 0 ) {
+      if ( mant == 0 ) {
+	x = sign;
+      } else {       // renormalise subnormal
+	exp = 127-15+1;
+	while ( !(mant&0x400) ) { mant<<=1; exp--; }
+	mant&=0x3ff;
+	x = sign | (exp<<23) | (mant<<13);
+      }
+    } else if ( exp == 0x1f ) {
+      x = sign | 0x7f800000 | (mant<<13);
+    } else {
+      x = sign | ((exp-15+127)<<23) | (mant<<13);
+    }
+    RealF f;
+    std::memcpy(&f,&x,sizeof(f));
+    return f;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////////////////
+  // Pack any object built from reals (scalar or SIMD, single or double) into RealH words
+  // behind a per object single precision scale; the largest element maps to unity.
+  //////////////////////////////////////////////////////////////////////////////////////////
+  template<class obj> inline int HalfWords(void)
+  {
+    typedef typename obj::scalar_type scalar_type;
+    typedef typename scalar_type::value_type real;
+    return sizeof(obj)/sizeof(real) + sizeof(RealF)/sizeof(RealH);
+  }
+
+  template<class obj> inline void PackHalf(RealH *out,const obj &in)
+  {
+    typedef typename obj::scalar_type scalar_type;
+    typedef typename scalar_type::value_type real;
+    const int words = sizeof(obj)/sizeof(real);
+    const real *r = (const real *)&in;
+
+    RealF scale = 0.0;
+    for(int w=0;w<words;w++) scale = std::max(scale,(RealF)std::fabs(r[w]));
+    RealF inv = (scale==0.0) ? 0.0 : 1.0/scale;
+
+    std::memcpy(out,&scale,sizeof(RealF));
+    out+=sizeof(RealF)/sizeof(RealH);
+    int w=0;
+#ifdef __F16C__
+    for(;w+8<=words;w+=8){
+      RealF f[8];
+      for(int i=0;i<8;i++) f[i]=r[w+i]*inv;
+      _mm_storeu_si128((__m128i *)&out[w],_mm256_cvtps_ph(_mm256_loadu_ps(f),_MM_FROUND_TO_NEAREST_INT));
+    }
+#endif
+    for(;w<words;w++) out[w] = FloatToHalf(r[w]*inv);
+  }
+
+  template<class obj> inline void UnpackHalf(obj &out,const RealH *in)
+  {
+    typedef typename obj::scalar_type scalar_type;
+    typedef typename scalar_type::value_type real;
+    const int words = sizeof(obj)/sizeof(real);
+    real *r = (real *)&out;
+
+    RealF scale;
+    std::memcpy(&scale,in,sizeof(RealF));
+    in+=sizeof(RealF)/sizeof(RealH);
+    int w=0;
+#ifdef __F16C__
+    for(;w+8<=words;w+=8){
+      RealF f[8];
+      _mm256_storeu_ps(f,_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)&in[w])));
+      for(int i=0;i<8;i++) r[w+i]=f[i]*scale;
+    }
+#endif
+    for(;w<words;w++) r[w] = HalfToFloat(in[w])*scale;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////////////////
+  // Storage only site object: N packed copies of vobj, each behind its own scale. Lattices
+  // of these carry no algebra; kernels unpack an element to full precision before use.
+  //////////////////////////////////////////////////////////////////////////////////////////
+  template<class vobj,int N> class iHalfStorage {
+  public:
+    typedef typename vobj::scalar_type scalar_type;
+    typedef typename vobj::vector_type vector_type;
+    typedef typename scalar_type::value_type real;
+
+    static const int words = sizeof(vobj)/sizeof(real) + sizeof(RealF)/sizeof(RealH);
+
+    RealH _internal[N][words];
+
+    inline void pack  (int i,const vobj &in) { PackHalf(&_internal[i][0],in); }
+    inline void unpack(int i,vobj &out) const { UnpackHalf(out,&_internal[i][0]); }
+  };
+
+}
+#endif
@@ -20,7 +20,16 @@ LebesgueOrder::IndexInteger LebesgueOrder::alignup(IndexInteger n){
 LebesgueOrder::LebesgueOrder(GridBase *_grid) 
 {
   grid = _grid;
-  if ( Block[0]==0) ZGraph();
+  _block = Block;
+  if ( _block[0]==0) ZGraph();
+  else CartesianBlocking();
+}
+
+LebesgueOrder::LebesgueOrder(GridBase *_grid,const std::vector<int> &block) 
+{
+  grid = _grid;
+  _block = block;
+  if ( _block[0]==0) ZGraph();
   else CartesianBlocking();
 }
 
@@ -29,13 +38,12 @@ void LebesgueOrder::CartesianBlocking(void)
   _LebesgueReorder.resize(0);
 
   std::cout << GridLogMessage << " CartesianBlocking ";
-  for(int d=0;d<Block.size();d++) std::cout <<Block[d]<<" ";
+  for(int d=0;d<_block.size();d++) std::cout <<_block[d]<<" ";
   std::cout<<std::endl; 
 
   IndexInteger ND = grid->_ndimension;
 
-  assert(ND==4);
-  assert(ND==Block.size());
+  assert(ND==_block.size());
 
   std::vector<IndexInteger> dims(ND);
   std::vector<IndexInteger> xo(ND,0);
@@ -53,7 +61,7 @@ void LebesgueOrder::IterateO(int ND,int dim,
 	      std::vector<IndexInteger> & xi,
 	      std::vector<IndexInteger> &dims)
 {
-  for(xo[dim]=0;xo[dim]<dims[dim];xo[dim]+=Block[dim]){
+  for(xo[dim]=0;xo[dim]<dims[dim];xo[dim]+=_block[dim]){
     if ( dim > 0 ) {
       IterateO(ND,dim-1,xo,xi,dims);
     } else {
@@ -69,7 +77,7 @@ void LebesgueOrder::IterateI(int ND,
 	      std::vector<IndexInteger> &dims)
 {
   std::vector<IndexInteger> x(ND);
-  for(xi[dim]=0;xi[dim]<std::min(dims[dim]-xo[dim],Block[dim]);xi[dim]++){
+  for(xi[dim]=0;xi[dim]<std::min(dims[dim]-xo[dim],_block[dim]);xi[dim]++){
     if ( dim > 0 ) {
       IterateI(ND,dim-1,xo,xi,dims);
     } else {
@@ -149,10 +157,12 @@ void LebesgueOrder::ZGraph(void)
     }
     
     if ( contained ) {
-      int site = ax[0]
-	+        dims[0]*ax[1]
-	+dims[0]*dims[1]*ax[2]
-	+dims[0]*dims[1]*dims[2]*ax[3];
+      int site   = 0;
+      int stride = 1;
+      for(int mu=0;mu<ND;mu++){
+	site  += stride*ax[mu];
+	stride = stride*dims[mu];
+      }
 
       assert(site < vol);
       _LebesgueReorder.push_back(site);
@@ -160,15 +170,12 @@ void LebesgueOrder::ZGraph(void)
   }
   assert( _LebesgueReorder.size() == vol );
 
-  std::vector<int> coor(4);
+  std::vector<int> coor(ND);
   for(IndexInteger asite=0;asite<vol;asite++){
     grid->oCoorFromOindex (coor,_LebesgueReorder[asite]);
-      std::cout << " site "<<asite << "->" << _LebesgueReorder[asite]<< " = ["
-		<< coor[0]<<","
-		<< coor[1]<<","
-		<< coor[2]<<","
-		<< coor[3]<<"]"
-		<<std::endl;
+      std::cout << " site "<<asite << "->" << _LebesgueReorder[asite]<< " = [";
+      for(int mu=0;mu<ND;mu++) std::cout << coor[mu] << ((mu<ND-1) ? "," : "]");
+      std::cout <<std::endl;
   }
 }
 }
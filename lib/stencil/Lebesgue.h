@@ -16,6 +16,7 @@ namespace Grid {
 
   public:
     LebesgueOrder(GridBase *_grid);
+    LebesgueOrder(GridBase *_grid,const std::vector<int> &block);
 
     inline IndexInteger Reorder(IndexInteger ss) { 
       return _LebesgueReorder[ss] ;
@@ -42,6 +43,7 @@ namespace Grid {
 		  std::vector<IndexInteger> &dims);
 
   private:
+    std::vector<int> _block;
     std::vector<IndexInteger> _LebesgueReorder;
 
   };    
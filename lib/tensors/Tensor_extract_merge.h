@@ -123,12 +123,14 @@ void extract(const vobj &vec,std::vector<typename vobj::scalar_object *> &extrac
 
   int Nextr=extracted.size();
   int s = Nsimd/Nextr;
-  scalar_type * vp = (scalar_type *)&vec;
+  // Byte copies: vec is usually a temporary and scalar_type may not alias the
+  // simd vector type, so dereferencing a cast pointer reads stale stack at -O2
+  const char * vp = (const char *)&vec;
 
   for(int w=0;w<words;w++){
     for(int i=0;i<Nextr;i++){
-      scalar_type * pointer = (scalar_type *)& extracted[i][offset];
-      pointer[w] = vp[i*s+w*Nsimd];
+      char * pointer = (char *)& extracted[i][offset];
+      memcpy(pointer+w*sizeof(scalar_type),vp+(i*s+w*Nsimd)*sizeof(scalar_type),sizeof(scalar_type));
     }
   }
 }
@@ -173,14 +175,14 @@ void merge(vobj &vec,std::vector<typename vobj::scalar_object *> &extracted,int
   int Nextr=extracted.size();
   int s=Nsimd/Nextr;
 
-  scalar_type *pointer;
-  scalar_type *vp = (scalar_type *)&vec;
+  char *pointer;
+  char *vp = (char *)&vec; // byte copies, as in extract
 
   for(int w=0;w<words;w++){
     for(int i=0;i<Nextr;i++){
       for(int ii=0;ii<s;ii++){
-	pointer=(scalar_type *)&extracted[i][offset];
-	vp[w*Nsimd+i*s+ii] = pointer[w];
+	pointer=(char *)&extracted[i][offset];
+	memcpy(vp+(w*Nsimd+i*s+ii)*sizeof(scalar_type),pointer+w*sizeof(scalar_type),sizeof(scalar_type));
       }
     }
   }
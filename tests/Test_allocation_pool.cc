@@ -0,0 +1,101 @@
+#include <Grid.h>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian * UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds);
+
+  LatticeFermion src(UGrid); random(RNG4,src);
+  LatticeFermion ref(UGrid); ref = 2.0*src;
+
+  AllocationPool::Statistics s0 = AllocationPool::Stats();
+
+  // Temporaries of one size: after the first the free list serves them all
+  int ntemp=10;
+  for(int i=0;i<ntemp;i++){
+    LatticeFermion tmp(UGrid);
+    assert( ((uint64_t)&tmp._odata[0] % 128)==0 );
+    tmp = src+src;
+    tmp = tmp-ref;
+    assert(norm2(tmp)==0.0);
+  }
+
+  AllocationPool::Statistics s1 = AllocationPool::Stats();
+  std::cout<<GridLogMessage<<"hits "<<s1.hits-s0.hits<<" misses "<<s1.misses-s0.misses<<std::endl;
+  assert(s1.hits-s0.hits >= ntemp-1);
+  assert(s1.bytes_in_use == s0.bytes_in_use);
+  assert(s1.peak_bytes_in_use >= s1.bytes_in_use+sizeof(src._odata[0])*UGrid->oSites());
+
+  // Idle blocks go back to the system; the next temporary is a miss
+  AllocationPool::Release();
+  AllocationPool::Statistics s2 = AllocationPool::Stats();
+  assert(s2.bytes_cached == 0);
+  {
+    LatticeFermion tmp(UGrid);
+  }
+  AllocationPool::Statistics s3 = AllocationPool::Stats();
+  assert(s3.misses == s2.misses+1);
+
+  // Huge page backed fields; 2MB aligned whether or not MAP_HUGETLB succeeded
+  AllocationPool::HugePages=1;
+  AllocationPool::Release();
+  {
+    LatticeGaugeField U(UGrid);
+    LatticeGaugeField V(UGrid);
+    if ( sizeof(U._odata[0])*UGrid->oSites() >= AllocationPool::HugePageBytes ) {
+      AllocationPool::Statistics s4 = AllocationPool::Stats();
+      assert(s4.mapped >= s3.mapped+2);
+      assert( ((uint64_t)&U._odata[0] % AllocationPool::HugePageBytes)==0 );
+      std::cout<<GridLogMessage<<"huge page blocks "<<s4.mapped<<" MAP_HUGETLB "<<s4.hugetlb<<std::endl;
+    }
+    random(RNG4,U);
+    V = U;
+    V = V-U;
+    assert(norm2(V)==0.0);
+  }
+  AllocationPool::Release();
+  AllocationPool::HugePages=0;
+
+  // Per category footprint
+  uint64_t fbytes = sizeof(src._odata[0])*UGrid->oSites();
+  uint64_t other  = AllocationPool::LiveBytes("Other");
+  {
+    AllocationCategory category("Test");
+    LatticeFermion a(UGrid);
+    LatticeFermion b(UGrid);
+    {
+      AllocationCategory inner("TestInner");
+      LatticeFermion c(UGrid);
+      assert(AllocationPool::LiveBytes("TestInner")==fbytes);
+    }
+    assert(AllocationPool::LiveBytes("TestInner")==0);
+    assert(AllocationPool::PeakBytes("TestInner")==fbytes);
+    assert(AllocationPool::LiveBytes("Test")==2*fbytes);
+
+    AllocationPool::Attribute(&b._odata[0],"TestMoved");
+    assert(AllocationPool::LiveBytes("Test")==fbytes);
+    assert(AllocationPool::LiveBytes("TestMoved")==fbytes);
+  }
+  assert(AllocationPool::LiveBytes("Test")==0);
+  assert(AllocationPool::LiveBytes("TestMoved")==0);
+  assert(AllocationPool::LiveBytes("Other")==other);
+  {
+    // A new high water mark records the breakdown at that moment
+    AllocationCategory category("TestPeak");
+    uint64_t peak = AllocationPool::Stats().peak_bytes_in_use;
+    std::vector<LatticeFermion> big(peak/fbytes+1,UGrid);
+    assert(AllocationPool::HighWaterBytes("TestPeak") >= peak);
+  }
+
+  AllocationPool::Report();
+
+  Grid_finalize();
+}
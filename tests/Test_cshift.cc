@@ -81,5 +81,25 @@ int main (int argc, char ** argv)
     }
   }
 
+  // Batched shifts in every direction at once must agree with the single shifts
+  std::vector<LatticeComplex> Us(8,&Fine);
+  std::vector<LatticeComplex> ShiftUs(8,&Fine);
+  std::vector<int> dirs(8);
+  std::vector<int> shifts(8);
+  for(int shift=1;shift<=2;shift++){
+    for(int i=0;i<8;i++){
+      dirs[i]   = i%4;
+      shifts[i] = (i<4) ? shift : -shift;
+      Us[i]     = U*Complex(i+1);
+    }
+    Cshift(ShiftUs,Us,dirs,shifts);
+    for(int i=0;i<8;i++){
+      ShiftU = Cshift(Us[i],dirs[i],shifts[i]) - ShiftUs[i];
+      double nrm = norm2(ShiftU);
+      std::cout<<GridLogMessage<<"Batched shift "<<shifts[i]<<" in direction "<<dirs[i]<<" diff "<<nrm<<std::endl;
+      if (nrm > 0) std::cerr<<"FAIL batched shift "<<shifts[i]<<" in dir "<<dirs[i]<<std::endl;
+    }
+  }
+
   Grid_finalize();
 }
@@ -0,0 +1,94 @@
+#include <Grid.h>
+#include <cstdio>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+template<class What>
+void TestTuned(What & Dref,What & Dtuned,GridBase *FGrid,GridParallelRNG *RNG);
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+
+  LatticeGaugeField Umu(UGrid); random(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5  =1.8;
+
+  // Start from an empty cache so that both operators are timed
+  DslashTuner::CacheFile = std::string("Test_dslash_tune.cache");
+  DslashTuner::Calls     = 2;
+  if ( UGrid->IsBoss() ) std::remove(DslashTuner::CacheFile.c_str());
+  UGrid->Barrier();
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Tuned against default: DomainWallFermion "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  DslashTuner::Enabled=0;
+  DomainWallFermionR Dref(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  DslashTuner::Enabled=1;
+  DomainWallFermionR Dtuned(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  TestTuned<DomainWallFermionR>(Dref,Dtuned,FGrid,&RNG5);
+
+  // Same key; taken from the cache without timing
+  DomainWallFermionR Dcached(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  TestTuned<DomainWallFermionR>(Dref,Dcached,FGrid,&RNG5);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Tuned against default: WilsonFermion "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  GridParallelRNG          RNG4f(UGrid);  RNG4f.SeedFixedIntegers(seeds5);
+  DslashTuner::Enabled=0;
+  WilsonFermionR Wref(Umu,*UGrid,*UrbGrid,mass);
+  DslashTuner::Enabled=1;
+  WilsonFermionR Wtuned(Umu,*UGrid,*UrbGrid,mass);
+  TestTuned<WilsonFermionR>(Wref,Wtuned,UGrid,&RNG4f);
+
+  if ( UGrid->IsBoss() ) {
+    std::ifstream f(DslashTuner::CacheFile.c_str());
+    std::string line;
+    int entries=0;
+    while ( std::getline(f,line) ) entries++;
+    std::cout<<GridLogMessage<<"cache entries "<<entries<<" (expect 2)"<<std::endl;
+    assert(entries==2);
+  }
+
+  // Leave no cache behind for the next run or for other tests
+  UGrid->Barrier();
+  if ( UGrid->IsBoss() ) std::remove(DslashTuner::CacheFile.c_str());
+
+  Grid_finalize();
+}
+
+template<class What>
+void TestTuned(What & Dref,What & Dtuned,GridBase *FGrid,GridParallelRNG *RNG)
+{
+  LatticeFermion src(FGrid); random(*RNG,src);
+  LatticeFermion ref(FGrid);
+  LatticeFermion res(FGrid);
+
+  for(int dag=0;dag<2;dag++){
+    Dref.Dhop  (src,ref,dag);
+    Dtuned.Dhop(src,res,dag);
+    RealD nref = norm2(ref);
+    ref = ref-res;
+    RealD diff = norm2(ref);
+    // Generic and hand kernels agree to rounding
+    std::cout<<GridLogMessage<<"Dhop dag "<<dag<<" kernel "<<DslashTuner::KernelName(Dtuned.DslashKernel())
+	     <<" norm diff "<<diff<<std::endl;
+    assert(diff <= 1.0e-20*nref);
+  }
+}
@@ -0,0 +1,75 @@
+#include <Grid.h>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds);
+
+  LatticeFermion src(UGrid); random(RNG4,src);
+  LatticeFermion diff(UGrid);
+
+  // Copies carry the payload
+  LatticeFermion copy(src);
+  diff = copy-src;
+  assert(norm2(diff)==0.0);
+
+  LatticeFermion src_o(UrbGrid);
+  pickCheckerboard(Odd,src_o,src);
+  LatticeFermion copy_o(src_o);
+  assert(copy_o.checkerboard==Odd);
+  LatticeFermion assign_o(UrbGrid);
+  assign_o = copy_o;
+  assert(assign_o.checkerboard==Odd);
+  assign_o = assign_o-src_o;
+  assert(norm2(assign_o)==0.0);
+
+  // Moves steal it
+  void *payload = &copy._odata[0];
+  LatticeFermion moved(std::move(copy));
+  assert(&moved._odata[0]==payload);
+  LatticeFermion target(UGrid);
+  target = std::move(moved);
+  assert(&target._odata[0]==payload);
+  static_assert(std::is_nothrow_move_constructible<LatticeFermion>::value,"move may throw");
+  static_assert(std::is_nothrow_move_assignable<LatticeFermion>::value,"move may throw");
+
+  // Moved from lattices are sized again by assignment
+  moved = zero;
+  assert(moved._odata.size()==UGrid->oSites());
+  assert(norm2(moved)==0.0);
+  copy = src*2.0;
+  assert(copy._odata.size()==UGrid->oSites());
+  diff = copy-src-src;
+  assert(norm2(diff)==0.0);
+  std::cout<<GridLogMessage<<"copy and move agree"<<std::endl;
+
+  // Compound assignment is in place and matches the explicit forms
+  AllocationPool::Statistics s0 = AllocationPool::Stats();
+  target += src;
+  target -= 3.0*src;
+  target *= 2.0;
+  target += 2.0*src;
+  AllocationPool::Statistics s1 = AllocationPool::Stats();
+  assert(s1.hits==s0.hits && s1.misses==s0.misses);
+  assert(&target._odata[0]==payload);
+  assert(norm2(target)<=1.0e-28*norm2(src));
+
+  LatticeColourMatrix U(UGrid); random(RNG4,U);
+  LatticeColourMatrix V(UGrid); random(RNG4,V);
+  LatticeColourMatrix W(U);
+  W *= V;
+  W -= U*V;
+  assert(norm2(W)<=1.0e-28*norm2(U));
+  std::cout<<GridLogMessage<<"compound assignment agrees"<<std::endl;
+
+  Grid_finalize();
+}
@@ -0,0 +1,115 @@
+#include <Grid.h>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+template<class What> 
+void TestFused(What & Dw,GridCartesian *FGrid,GridRedBlackCartesian *FrbGrid,GridParallelRNG *RNG);
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::vector<int> latt_size   = GridDefaultLatt();
+  std::vector<int> simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  std::vector<int> mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(latt_size,simd_layout,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          pRNG(&Grid);
+  pRNG.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField Umu(&Grid); random(pRNG,Umu);
+
+  RealD mass=0.1;
+  RealD mu  =0.3;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Fused Dhop epilogue: WilsonFermion "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  WilsonFermionR Dw(Umu,Grid,RBGrid,mass);
+  TestFused<WilsonFermionR>(Dw,&Grid,&RBGrid,&pRNG);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Composed products: WilsonTMFermion "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  WilsonTMFermionR Dtm(Umu,Grid,RBGrid,mass,mu);
+  TestFused<WilsonTMFermionR>(Dtm,&Grid,&RBGrid,&pRNG);
+
+  Grid_finalize();
+}
+
+template<class What> 
+void TestFused(What & Dw,GridCartesian *FGrid,GridRedBlackCartesian *FrbGrid,GridParallelRNG *RNG)
+{
+  typedef CheckerBoardedSparseMatrixBase<LatticeFermion> Base;
+
+  LatticeFermion src   (FGrid); random(*RNG,src);
+  LatticeFermion result(FGrid);
+  LatticeFermion    ref(FGrid);
+  RealD nfused, nref, rel;
+
+  // M = Dhop + Mooee on the full grid
+  for(int dag=0;dag<2;dag++){
+    if ( dag ) nfused = Dw.Mdag(src,result);
+    else       nfused = Dw.M   (src,result);
+    Dw.Dhop(src,ref,dag);
+    nref = axpy_norm(ref,4.0+Dw.mass,src,ref);
+    ref  = result-ref;
+    rel  = std::sqrt(norm2(ref)/nref);
+    std::cout<<GridLogMessage<<"M dag "<<dag<<" relative error "<<rel<<" norm "<<nfused<<" vs "<<nref<<std::endl;
+    assert(rel < 1.0e-12);
+    assert(std::fabs(nfused-nref) < 1.0e-10*nref);
+  }
+
+  LatticeFermion src_e (FrbGrid);
+  LatticeFermion tmp_o (FrbGrid);
+  LatticeFermion ref_o (FrbGrid);
+  LatticeFermion r_e   (FrbGrid);
+  LatticeFermion ref_e (FrbGrid);
+  LatticeFermion x_o   (FrbGrid);
+  pickCheckerboard(Even,src_e,src);
+
+  for(int dag=0;dag<2;dag++){
+    Dw.MooeeInvMeooe(src_e,tmp_o,x_o,dag);
+    Dw.Base::MooeeInvMeooe(src_e,ref_o,x_o,dag);
+    ref_o = tmp_o-ref_o;
+    rel = std::sqrt(norm2(ref_o)/norm2(tmp_o));
+    std::cout<<GridLogMessage<<"MooeeInvMeooe dag "<<dag<<" relative error "<<rel<<std::endl;
+    assert(rel < 1.0e-12);
+
+    x_o    = tmp_o; // the composed default overwrites x
+    nfused = Dw.MooeeMinusMeooe(src_e,x_o,r_e,dag);
+    x_o    = tmp_o;
+    nref   = Dw.Base::MooeeMinusMeooe(src_e,x_o,ref_e,dag);
+    ref_e  = r_e-ref_e;
+    rel = std::sqrt(norm2(ref_e)/nref);
+    std::cout<<GridLogMessage<<"MooeeMinusMeooe dag "<<dag<<" relative error "<<rel<<" norm "<<nfused<<" vs "<<nref<<std::endl;
+    assert(rel < 1.0e-12);
+    assert(std::fabs(nfused-nref) < 1.0e-10*nref);
+  }
+
+  // Schur operator against the products written out by hand
+  SchurDiagMooeeOperator<What,LatticeFermion> HermOpEO(Dw);
+  nfused = HermOpEO.Mpc(src_e,r_e);
+  Dw.Meooe(src_e,tmp_o);
+  Dw.MooeeInv(tmp_o,ref_o);
+  Dw.Meooe(ref_o,tmp_o);
+  Dw.Mooee(src_e,ref_e);
+  nref = axpy_norm(ref_e,-1.0,tmp_o,ref_e);
+  ref_e = r_e-ref_e;
+  rel = std::sqrt(norm2(ref_e)/nref);
+  std::cout<<GridLogMessage<<"Mpc relative error "<<rel<<std::endl;
+  assert(rel < 1.0e-12);
+
+  // Fused or composed, Mpc takes a single temporary from the pool
+  AllocationPool::Statistics s0 = AllocationPool::Stats();
+  HermOpEO.Mpc(src_e,r_e);
+  HermOpEO.MpcDag(src_e,r_e);
+  AllocationPool::Statistics s1 = AllocationPool::Stats();
+  uint64_t allocs = (s1.hits+s1.misses)-(s0.hits+s0.misses);
+  std::cout<<GridLogMessage<<"Mpc and MpcDag pool allocations "<<allocs<<std::endl;
+  assert(allocs == 2);
+}
@@ -0,0 +1,121 @@
+#include <Grid.h>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::vector<int> latt_size   = GridDefaultLatt();
+  std::vector<int> simd_layout = GridDefaultSimd(Nd,vComplexF::Nsimd());
+  std::vector<int> mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(latt_size,simd_layout,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          pRNG(&Grid);
+  pRNG.SeedFixedIntegers(seeds);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Testing Wilson operator with binary16 link and spinor storage "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  typedef WilsonHalfImplF::SiteDoubledGaugeField HalfLinks;
+  typedef WilsonImplF::SiteDoubledGaugeField     FloatLinks;
+  std::cout<<GridLogMessage<<"Doubled links per site "<<sizeof(FloatLinks)<<" bytes float, "
+	   <<sizeof(HalfLinks)<<" bytes half"<<std::endl;
+  std::cout<<GridLogMessage<<"MdagM intermediate per site "<<sizeof(WilsonImplF::SiteSpinor)<<" bytes float, "
+	   <<sizeof(WilsonHalfImplF::SitePackedSpinor)<<" bytes half"<<std::endl;
+
+  LatticeFermionF src   (&Grid); random(pRNG,src);
+  LatticeFermionF result(&Grid); result=zero;
+  LatticeFermionF    ref(&Grid);    ref=zero;
+  LatticeFermionF    err(&Grid);
+  LatticeGaugeFieldF Umu(&Grid); 
+  {
+    // Hot SU(3) start is double only; narrow it site by site
+    GridCartesian    GridD(latt_size,GridDefaultSimd(Nd,vComplexD::Nsimd()),mpi_layout);
+    GridParallelRNG  pRNGD(&GridD);  pRNGD.SeedFixedIntegers(seeds);
+    LatticeGaugeFieldD UmuD(&GridD); SU3::HotConfiguration(pRNGD,UmuD);
+    LorentzColourMatrixD sD;
+    LorentzColourMatrixF sF;
+    std::vector<int> coor(Nd);
+    for(coor[3]=0;coor[3]<latt_size[3];coor[3]++){
+    for(coor[2]=0;coor[2]<latt_size[2];coor[2]++){
+    for(coor[1]=0;coor[1]<latt_size[1];coor[1]++){
+    for(coor[0]=0;coor[0]<latt_size[0];coor[0]++){
+      peekSite(sD,UmuD,coor);
+      for(int mu=0;mu<Nd;mu++){
+      for(int i=0;i<Nc;i++){
+      for(int j=0;j<Nc;j++){
+	sF(mu)()(i,j) = ComplexF(sD(mu)()(i,j));
+      }}}
+      pokeSite(sF,Umu,coor);
+    }}}}
+  }
+
+  RealD mass=0.1;
+  WilsonFermionF     Dw    (Umu,Grid,RBGrid,mass);
+  WilsonHalfFermionF Dwhalf(Umu,Grid,RBGrid,mass);
+
+  for(int dag=0;dag<2;dag++){
+    Dw.Dhop    (src,ref   ,dag);
+    Dwhalf.Dhop(src,result,dag);
+    err = result-ref;
+    RealD rel = std::sqrt(norm2(err)/norm2(ref));
+    std::cout<<GridLogMessage<<"dag "<<dag<<" relative error "<<rel<<std::endl;
+    assert(rel < 1.0e-3); // binary16 carries 11 significant bits
+  }
+
+  LatticeFermionF src_e   (&RBGrid);
+  LatticeFermionF r_o     (&RBGrid);
+  LatticeFermionF r_o_half(&RBGrid);
+  pickCheckerboard(Even,src_e,src);
+  Dw.Meooe    (src_e,r_o);
+  Dwhalf.Meooe(src_e,r_o_half);
+  r_o_half = r_o_half - r_o;
+  RealD rel = std::sqrt(norm2(r_o_half)/norm2(r_o));
+  std::cout<<GridLogMessage<<"Meo relative error "<<rel<<std::endl;
+  assert(rel < 1.0e-3);
+
+  // MdagM keeps its intermediate in binary16, in single precision only on the faces
+  LatticeFermionF mm    (&Grid);
+  LatticeFermionF mm_half(&Grid);
+  RealD n1,n2,n1_half,n2_half;
+  Dwhalf.MdagM(src,mm_half,n1_half,n2_half); // first, so its intermediate cannot reuse a float one
+  Dw.MdagM    (src,mm     ,n1     ,n2);
+  mm_half = mm_half - mm;
+  rel = std::sqrt(norm2(mm_half)/norm2(mm));
+  std::cout<<GridLogMessage<<"MdagM relative error "<<rel<<" norms "<<n1_half/n1<<" "<<n2_half/n2<<std::endl;
+  assert(rel < 1.0e-3);
+  assert(std::fabs(n1_half/n1-1.0) < 1.0e-3);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Defect correction with the binary16 operator inside "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  MdagMLinearOperator<WilsonFermionF    ,LatticeFermionF> HermOp    (Dw);
+  MdagMLinearOperator<WilsonHalfFermionF,LatticeFermionF> HermOpHalf(Dwhalf);
+  ConjugateGradient<LatticeFermionF> CG(1.0e-2,10000);
+
+  LatticeFermionF psi(&Grid); psi=zero;
+  LatticeFermionF res(&Grid);
+  LatticeFermionF cor(&Grid);
+  RealD ssq = norm2(src);
+  int outer;
+  for(outer=0;outer<20;outer++){
+    HermOp.HermOp(psi,res);
+    res = src-res;
+    rel = std::sqrt(norm2(res)/ssq);
+    std::cout<<GridLogMessage<<"outer "<<outer<<" true residual "<<rel<<std::endl;
+    if ( rel < 1.0e-4 ) break; // outer residual is single precision too
+    cor=zero;
+    CG(HermOpHalf,res,cor);
+    psi = psi+cor;
+  }
+  assert(rel < 1.0e-4);
+
+  Grid_finalize();
+}
@@ -0,0 +1,134 @@
+#include <Grid.h>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::vector<int> latt_size   = GridDefaultLatt();
+  std::vector<int> simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  std::vector<int> mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(latt_size,simd_layout,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          pRNG(&Grid);
+  pRNG.SeedFixedIntegers(seeds);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Testing binary16 conversion "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  // Every finite half converts to float and back exactly
+  int bad=0;
+  for(int h=0;h<0x10000;h++){
+    if ( (h&0x7c00)==0x7c00 ) continue;
+    if ( FloatToHalf(HalfToFloat(h)) != h ) bad++;
+  }
+  std::cout<<GridLogMessage<<"half->float->half mismatches "<<bad<<std::endl;
+  assert(bad==0);
+
+  LatticeFermion src   (&Grid); random(pRNG,src);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Testing face pack/unpack, on any number of ranks "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  // Compress a face as the stencil does, round trip it through binary16 both as SIMD
+  // objects and as the extracted scalar objects of the SIMD split path
+  {
+    typedef WilsonImplR::SiteHalfSpinor          SiteHalfSpinor;
+    typedef SiteHalfSpinor::scalar_object        ScalarHalfSpinor;
+    typedef SiteHalfSpinor::scalar_type          scalar_type;
+    typedef scalar_type::value_type              real;
+    int Nsimd = Grid.Nsimd();
+    for(int dag=0;dag<2;dag++){
+    for(int point=0;point<2*Nd;point++){
+      int dim = point%Nd;
+      int words = Grid._slice_nblock[dim]*Grid._slice_block[dim];
+      WilsonImplR::Compressor compress(dag,1);
+      compress.Point(point);
+      assert(compress.HalfPrecisionComms());
+
+      std::vector<SiteHalfSpinor,alignedAllocator<SiteHalfSpinor> > face(words);
+      Gather_plane_simple(src,face,dim,0,0x3,compress);
+
+      std::vector<RealH> hbuf(HalfWords<SiteHalfSpinor>());
+      std::vector<RealH> hsbuf(HalfWords<ScalarHalfSpinor>());
+      std::vector<ScalarHalfSpinor> ext(Nsimd);
+      std::vector<ScalarHalfSpinor> sunpacked(Nsimd);
+      RealD nrm=0.0, vdiff=0.0, sdiff=0.0;
+      for(int i=0;i<words;i++){
+	SiteHalfSpinor unpacked;
+	PackHalf(&hbuf[0],face[i]);
+	UnpackHalf(unpacked,&hbuf[0]);
+
+	extract(face[i],ext);
+	for(int l=0;l<Nsimd;l++){
+	  PackHalf(&hsbuf[0],ext[l]);
+	  UnpackHalf(sunpacked[l],&hsbuf[0]);
+	}
+
+	const real *f = (const real *)&face[i];
+	const real *u = (const real *)&unpacked;
+	for(int w=0;w<sizeof(SiteHalfSpinor)/sizeof(real);w++){
+	  nrm   += f[w]*f[w];
+	  vdiff += (u[w]-f[w])*(u[w]-f[w]);
+	}
+	for(int l=0;l<Nsimd;l++){
+	  const real *e = (const real *)&ext[l];
+	  const real *s = (const real *)&sunpacked[l];
+	  for(int w=0;w<sizeof(ScalarHalfSpinor)/sizeof(real);w++){
+	    sdiff += (s[w]-e[w])*(s[w]-e[w]);
+	  }
+	}
+      }
+      RealD vrel = std::sqrt(vdiff/nrm);
+      RealD srel = std::sqrt(sdiff/nrm);
+      std::cout<<GridLogMessage<<"dag "<<dag<<" point "<<point<<" face relative error "
+	       <<vrel<<" simd, "<<srel<<" scalar"<<std::endl;
+      assert(vrel < 5.0e-4); // 2^-11 of each object's largest element, at worst
+      assert(srel < 5.0e-4);
+    }}
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Testing Dhop with half precision halo exchange "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  LatticeFermion result(&Grid); result=zero;
+  LatticeFermion    ref(&Grid);    ref=zero;
+  LatticeFermion    err(&Grid);
+  LatticeGaugeField Umu(&Grid); random(pRNG,Umu);
+
+  RealD mass=0.1;
+  WilsonImplParams params;
+  params.halfprecision_comms = true;
+  WilsonFermionR Dw    (Umu,Grid,RBGrid,mass);
+  WilsonFermionR Dwhalf(Umu,Grid,RBGrid,mass,params);
+
+  for(int dag=0;dag<2;dag++){
+    Dw.Dhop    (src,ref   ,dag);
+    Dwhalf.Dhop(src,result,dag);
+    err = result-ref;
+    RealD rel = std::sqrt(norm2(err)/norm2(ref));
+    std::cout<<GridLogMessage<<"dag "<<dag<<" relative error "<<rel<<std::endl;
+    assert(rel < 1.0e-4); // only the surface sites see binary16 neighbours
+  }
+
+  LatticeFermion src_e   (&RBGrid);
+  LatticeFermion r_o     (&RBGrid);
+  LatticeFermion r_o_half(&RBGrid);
+  pickCheckerboard(Even,src_e,src);
+  Dw.Meooe    (src_e,r_o);
+  Dwhalf.Meooe(src_e,r_o_half);
+  r_o_half = r_o_half - r_o;
+  RealD rel = std::sqrt(norm2(r_o_half)/norm2(r_o));
+  std::cout<<GridLogMessage<<"Meo relative error "<<rel<<std::endl;
+  assert(rel < 1.0e-4);
+
+  Grid_finalize();
+}
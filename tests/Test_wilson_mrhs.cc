@@ -0,0 +1,144 @@
+#include <Grid.h>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Nrhs=4;
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Nrhs,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Nrhs,UGrid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField Umu(UGrid); random(RNG4,Umu);
+
+  RealD mass=0.1;
+  WilsonFermionR         Dw(Umu,*UGrid,*UrbGrid,mass);
+  WilsonMultiRHSFermionR Dm(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass);
+
+  std::vector<LatticeFermion> src(Nrhs,UGrid);
+  std::vector<LatticeFermion> res(Nrhs,UGrid);
+  std::vector<LatticeFermion> ref(Nrhs,UGrid);
+  for(int s=0;s<Nrhs;s++) random(RNG4,src[s]);
+
+  LatticeFermion bsrc(FGrid);
+  LatticeFermion bres(FGrid);
+  Dm.ImportSources(src,bsrc);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Block operator against "<<Nrhs<<" single source applications"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  for(int dag=0;dag<2;dag++){
+    if ( dag ) Dm.Mdag(bsrc,bres);
+    else       Dm.M   (bsrc,bres);
+    Dm.ExportSources(bres,res);
+    for(int s=0;s<Nrhs;s++){
+      if ( dag ) Dw.Mdag(src[s],ref[s]);
+      else       Dw.M   (src[s],ref[s]);
+      RealD nref = norm2(ref[s]);
+      ref[s] = ref[s]-res[s];
+      RealD diff = norm2(ref[s]);
+      std::cout<<GridLogMessage<<"M dag "<<dag<<" rhs "<<s<<" norm diff "<<diff<<" of "<<nref<<std::endl;
+      assert(diff <= 1.0e-20*nref);
+    }
+  }
+
+  for(int mu=0;mu<Nd;mu++){
+    Dm.Mdir(bsrc,bres,mu,1);
+    Dm.ExportSources(bres,res);
+    for(int s=0;s<Nrhs;s++){
+      Dw.Mdir(src[s],ref[s],mu,1);
+      RealD nref = norm2(ref[s]);
+      ref[s] = ref[s]-res[s];
+      RealD diff = norm2(ref[s]);
+      assert(diff <= 1.0e-20*nref);
+    }
+  }
+  std::cout<<GridLogMessage<<"Mdir agrees"<<std::endl;
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Even odd pieces"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    std::vector<LatticeFermion> src_o(Nrhs,UrbGrid);
+    std::vector<LatticeFermion> res_e(Nrhs,UrbGrid);
+    std::vector<LatticeFermion> ref_e(Nrhs,UrbGrid);
+    for(int s=0;s<Nrhs;s++) pickCheckerboard(Odd,src_o[s],src[s]);
+
+    LatticeFermion bsrc_o(FrbGrid);
+    LatticeFermion bres_e(FrbGrid);
+    LatticeFermion btmp_e(FrbGrid);
+    Dm.ImportSources(src_o,bsrc_o);
+
+    for(int dag=0;dag<2;dag++){
+      if ( dag ) Dm.MeooeDag(bsrc_o,btmp_e);
+      else       Dm.Meooe   (bsrc_o,btmp_e);
+      Dm.MooeeInv(btmp_e,bres_e);
+      Dm.ExportSources(bres_e,res_e);
+      for(int s=0;s<Nrhs;s++){
+	LatticeFermion tmp(UrbGrid);
+	if ( dag ) Dw.MeooeDag(src_o[s],tmp);
+	else       Dw.Meooe   (src_o[s],tmp);
+	Dw.MooeeInv(tmp,ref_e[s]);
+	assert(res_e[s].checkerboard==Even);
+	RealD nref = norm2(ref_e[s]);
+	ref_e[s] = ref_e[s]-res_e[s];
+	RealD diff = norm2(ref_e[s]);
+	std::cout<<GridLogMessage<<"MooeeInv Meooe dag "<<dag<<" rhs "<<s<<" norm diff "<<diff<<std::endl;
+	assert(diff <= 1.0e-20*nref);
+      }
+    }
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Timing: one block Dhop against "<<Nrhs<<" single Dhops"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    int ncall=10;
+    double volume=Nrhs;
+    for(int mu=0;mu<Nd;mu++) volume=volume*UGrid->_fdimensions[mu];
+    double flops=1320.0*volume*ncall;
+
+    Dm.Dhop(bsrc,bres,DaggerNo);
+    double t0=usecond();
+    for(int i=0;i<ncall;i++) Dm.Dhop(bsrc,bres,DaggerNo);
+    double t1=usecond();
+    for(int i=0;i<ncall;i++){
+      for(int s=0;s<Nrhs;s++) Dw.Dhop(src[s],ref[s],DaggerNo);
+    }
+    double t2=usecond();
+    std::cout<<GridLogMessage<<"block  Dhop "<<(t1-t0)/ncall/Nrhs<<" us per rhs; mflop/s = "<<flops/(t1-t0)<<std::endl;
+    std::cout<<GridLogMessage<<"single Dhop "<<(t2-t1)/ncall/Nrhs<<" us per rhs; mflop/s = "<<flops/(t2-t1)<<std::endl;
+  }
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Block red black CG against single source solves"<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  {
+    ConjugateGradient<LatticeFermion> CG(1.0e-8,10000);
+    SchurRedBlackDiagMooeeSolve<LatticeFermion> SchurSolver(CG);
+
+    bres=zero;
+    SchurSolver(Dm,bsrc,bres);
+    Dm.ExportSources(bres,res);
+
+    for(int s=0;s<Nrhs;s++){
+      ref[s]=zero;
+      SchurSolver(Dw,src[s],ref[s]);
+      RealD nref = norm2(ref[s]);
+      ref[s] = ref[s]-res[s];
+      RealD diff = norm2(ref[s]);
+      std::cout<<GridLogMessage<<"solution rhs "<<s<<" relative difference "<<std::sqrt(diff/nref)<<std::endl;
+      assert(diff <= 1.0e-10*nref);
+    }
+  }
+
+  Grid_finalize();
+}
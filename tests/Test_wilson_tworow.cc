@@ -0,0 +1,68 @@
+#include <Grid.h>
+
+using namespace std;
+using namespace Grid;
+using namespace Grid::QCD;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  std::vector<int> latt_size   = GridDefaultLatt();
+  std::vector<int> simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  std::vector<int> mpi_layout  = GridDefaultMpi();
+  GridCartesian               Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian     RBGrid(latt_size,simd_layout,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG          pRNG(&Grid);
+  pRNG.SeedFixedIntegers(seeds);
+
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+  std::cout<<GridLogMessage<<"= Testing Wilson operator with two row link storage "<<std::endl;
+  std::cout<<GridLogMessage<<"=========================================================="<<std::endl;
+
+  LatticeFermion src   (&Grid); random(pRNG,src);
+  LatticeFermion result(&Grid); result=zero;
+  LatticeFermion    ref(&Grid);    ref=zero;
+  LatticeFermion    err(&Grid);
+  LatticeGaugeField Umu(&Grid); 
+  SU3::HotConfiguration(pRNG,Umu); // reconstruction assumes SU(3)
+
+  RealD mass=0.1;
+  WilsonFermionR       Dw  (Umu,Grid,RBGrid,mass);
+  WilsonTwoRowFermionR Dw2r(Umu,Grid,RBGrid,mass);
+
+  for(int dag=0;dag<2;dag++){
+    Dw.Dhop  (src,ref   ,dag);
+    Dw2r.Dhop(src,result,dag);
+    err = result-ref;
+    RealD rel = std::sqrt(norm2(err)/norm2(ref));
+    std::cout<<GridLogMessage<<"dag "<<dag<<" relative error "<<rel<<std::endl;
+    assert(rel < 1.0e-10);
+  }
+
+  LatticeFermion src_e (&RBGrid);
+  LatticeFermion r_o   (&RBGrid);
+  LatticeFermion r_o_2r(&RBGrid);
+  pickCheckerboard(Even,src_e,src);
+  Dw.Meooe  (src_e,r_o);
+  Dw2r.Meooe(src_e,r_o_2r);
+  r_o_2r = r_o_2r - r_o;
+  RealD rel = std::sqrt(norm2(r_o_2r)/norm2(r_o));
+  std::cout<<GridLogMessage<<"Meo relative error "<<rel<<std::endl;
+  assert(rel < 1.0e-10);
+
+  // Force term goes through DhopDir
+  LatticeGaugeField force  (&Grid);
+  LatticeGaugeField force2r(&Grid);
+  LatticeFermion    chi    (&Grid); random(pRNG,chi);
+  Dw.DhopDeriv  (force  ,chi,src,DaggerNo);
+  Dw2r.DhopDeriv(force2r,chi,src,DaggerNo);
+  force2r = force2r - force;
+  rel = std::sqrt(norm2(force2r)/norm2(force));
+  std::cout<<GridLogMessage<<"DhopDeriv relative error "<<rel<<std::endl;
+  assert(rel < 1.0e-10);
+
+  Grid_finalize();
+}